@@ -0,0 +1,122 @@
+#include "Animation.h"
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Per-frame sprite selection: the string-keyed maps the entities used to look
+// their sprites up in, the branches that replaced them, and the compile-time
+// state tables. Inputs are random player states and platform opacities; every
+// method must pick the same sprites, which the checksum column confirms.
+namespace {
+    constexpr size_t SAMPLES = 1 << 16;
+    constexpr int PASSES = 200;
+
+    struct Sprite { int id; };
+
+    struct PlayerSample {
+        bool lookingUp, falling, lookingRight;
+    };
+
+    // The old Player::update: build the key, then look it up.
+    struct PlayerMap {
+        std::map<std::string, std::unique_ptr<Sprite>> sprites;
+
+        PlayerMap() {
+            const char* keys[] = { "leftup", "leftdown", "rightup", "rightdown", "upup", "updown" };
+            for (int i = 0; i < 6; ++i) sprites[keys[i]] = std::make_unique<Sprite>(Sprite{ i });
+        }
+
+        const Sprite* select(const PlayerSample& s) {
+            std::string spriteKey;
+            if (s.lookingUp) spriteKey = s.falling ? "updown" : "upup";
+            else {
+                if (s.lookingRight) spriteKey = s.falling ? "rightdown" : "rightup";
+                else spriteKey = s.falling ? "leftdown" : "leftup";
+            }
+            return sprites[spriteKey].get();
+        }
+    };
+
+    struct PlatformMap {
+        std::map<std::string, std::unique_ptr<Sprite>> sprites;
+
+        PlatformMap() {
+            sprites["100"] = std::make_unique<Sprite>(Sprite{ 0 });
+            sprites["75"] = std::make_unique<Sprite>(Sprite{ 1 });
+            sprites["25"] = std::make_unique<Sprite>(Sprite{ 2 });
+        }
+
+        const Sprite* select(float opacity) {
+            if (opacity > 0.75f) return sprites["100"].get();
+            if (opacity > 0.25f) return sprites["75"].get();
+            return sprites["25"].get();
+        }
+    };
+
+    Sprite poseSprites[static_cast<size_t>(animation::PlayerPose::COUNT)] = { { 0 }, { 1 }, { 2 }, { 3 }, { 4 }, { 5 } };
+    Sprite platformSprites[static_cast<size_t>(animation::PlatformVariant::COUNT)] = { { 0 }, { 1 }, { 2 } };
+
+    const Sprite* playerBranches(const PlayerSample& s) {
+        using animation::PlayerPose;
+        PlayerPose pose;
+        if (s.lookingUp) pose = s.falling ? PlayerPose::UpDown : PlayerPose::UpUp;
+        else if (s.lookingRight) pose = s.falling ? PlayerPose::RightDown : PlayerPose::RightUp;
+        else pose = s.falling ? PlayerPose::LeftDown : PlayerPose::LeftUp;
+        return &poseSprites[static_cast<size_t>(pose)];
+    }
+
+    const Sprite* playerTable(const PlayerSample& s) {
+        RenderSnapshot snapshot;
+        snapshot.lookingUp = s.lookingUp;
+        snapshot.falling = s.falling;
+        snapshot.lookingRight = s.lookingRight;
+        return &poseSprites[static_cast<size_t>(animation::playerPose(snapshot))];
+    }
+
+    const Sprite* platformBranches(float opacity) {
+        return opacity > 0.75f ? &platformSprites[0] : opacity > 0.25f ? &platformSprites[1] : &platformSprites[2];
+    }
+
+    const Sprite* platformTable(float opacity) {
+        return &platformSprites[static_cast<size_t>(animation::platformVariant(opacity))];
+    }
+
+    template <typename Sample, typename Select>
+    void run(const char* name, const std::vector<Sample>& samples, Select select) {
+        uint64_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass)
+            for (const Sample& sample : samples) sum = sum * 7 + select(sample)->id;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%-20s %10.2f %18llx\n", name, seconds * 1e9 / (static_cast<double>(PASSES) * samples.size()),
+            static_cast<unsigned long long>(sum));
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<PlayerSample> players(SAMPLES);
+    for (PlayerSample& s : players) {
+        uint32_t bits = rng();
+        s = { (bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0 };
+    }
+    // Quarter-step opacities land exactly on the thresholds now and then.
+    std::vector<float> opacities(SAMPLES);
+    for (float& o : opacities) o = rng() % 4 == 0 ? (rng() % 5) * 0.25f : std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+
+    PlayerMap playerMap;
+    PlatformMap platformMap;
+
+    printf("%-20s %10s %18s\n", "selection", "ns/lookup", "checksum");
+    run("player string map", players, [&](const PlayerSample& s) { return playerMap.select(s); });
+    run("player branches", players, playerBranches);
+    run("player table", players, playerTable);
+    run("platform string map", opacities, [&](float o) { return platformMap.select(o); });
+    run("platform branches", opacities, platformBranches);
+    run("platform table", opacities, platformTable);
+    return 0;
+}
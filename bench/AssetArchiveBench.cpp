@@ -0,0 +1,102 @@
+#include "framework.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <psapi.h>
+#endif
+
+// Startup time and memory of loading every sprite from loose files (decoded
+// on load) against the packed archive (mapped, no decode). Each mode runs in
+// a fresh child process so one can't warm the other's heap; both draw every
+// sprite once so the archive's pages are actually touched. The private column
+// is memory only this process can use; mapped archive pages are file-backed
+// and shared with other instances. Run from the repository root after
+// building, or pass --material and --archive.
+namespace {
+    struct Memory {
+        double residentMb = 0.0;
+        double privateMb = 0.0;
+    };
+
+    Memory currentMemory() {
+        Memory memory;
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS_EX counters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters))) {
+            memory.residentMb = counters.WorkingSetSize / 1048576.0;
+            memory.privateMb = counters.PrivateUsage / 1048576.0;
+        }
+#else
+        FILE* file = fopen("/proc/self/status", "r");
+        if (!file) return memory;
+        char line[256];
+        while (fgets(line, sizeof(line), file)) {
+            long kb = 0;
+            if (sscanf(line, "VmRSS: %ld kB", &kb) == 1) memory.residentMb = kb / 1024.0;
+            else if (sscanf(line, "RssAnon: %ld kB", &kb) == 1) memory.privateMb = kb / 1024.0;
+        }
+        fclose(file);
+#endif
+        return memory;
+    }
+
+    int runMode(const std::string& mode, const std::string& material, const std::string& archivePath) {
+        std::vector<std::string> paths;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(material, error)) {
+            std::string extension = entry.path().extension().string();
+            if (extension == ".png" || extension == ".jpg") paths.push_back(material + "/" + entry.path().filename().string());
+        }
+        std::sort(paths.begin(), paths.end());
+        createFramebuffer(600, 800, nullptr);
+        Memory before = currentMemory();
+
+        auto start = std::chrono::steady_clock::now();
+        if (mode == "archive" && !mountAssetArchive(archivePath.c_str())) {
+            fprintf(stderr, "cannot map %s\n", archivePath.c_str());
+            return 1;
+        }
+        std::vector<Sprite*> sprites;
+        for (const std::string& path : paths) sprites.push_back(createSprite(path.c_str()));
+        for (Sprite* sprite : sprites) drawSprite(sprite, 0, 0);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        Memory after = currentMemory();
+        size_t loaded = static_cast<size_t>(std::count_if(sprites.begin(), sprites.end(), [](Sprite* s) { return s != nullptr; }));
+        printf("%-8s %8zu %12.2f %14.2f %14.2f\n", mode.c_str(), loaded, ms,
+            after.residentMb - before.residentMb, after.privateMb - before.privateMb);
+
+        for (Sprite* sprite : sprites) destroySprite(sprite);
+        unmountAssetArchive();
+        destroyFramebuffer();
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string material = "material";
+    std::string archivePath = "build/material.pak";
+    std::string mode;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--material") == 0 && i + 1 < argc) material = argv[++i];
+        else if (strcmp(argv[i], "--archive") == 0 && i + 1 < argc) archivePath = argv[++i];
+        else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) mode = argv[++i];
+    }
+    if (!mode.empty()) return runMode(mode, material, archivePath);
+
+    printf("%-8s %8s %12s %14s %14s\n", "source", "sprites", "startup ms", "rss +MB", "private +MB");
+    fflush(stdout);
+    int failed = 0;
+    for (const char* child : { "loose", "archive" }) {
+        std::string command = "\"" + std::string(argv[0]) + "\" --mode " + child + " --material \"" + material + "\" --archive \"" + archivePath + "\"";
+        if (std::system(command.c_str()) != 0) failed = 1;
+    }
+    return failed;
+}
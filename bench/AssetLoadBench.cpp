@@ -0,0 +1,59 @@
+#include "AssetLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Startup cost of decoding the game's images: one by one on the calling
+// thread, as the game used to before its first frame, against the parallel
+// AssetLoader. The material folder is repeated to grow the manifest; only
+// the first copy is critical, so the time until the first frame can be drawn
+// should stay flat while the total grows. Run from the repository root or
+// pass --material.
+namespace {
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string material = "material";
+    size_t threads = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--material") == 0 && i + 1 < argc) material = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = static_cast<size_t>(atoi(argv[++i]));
+    }
+
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(material, error)) {
+        std::string extension = entry.path().extension().string();
+        if (extension == ".png" || extension == ".jpg") files.push_back(entry.path().string());
+    }
+    if (files.empty()) { fprintf(stderr, "no images in %s\n", material.c_str()); return 1; }
+    std::sort(files.begin(), files.end());
+
+    printf("%-8s %8s %14s %14s %14s %10s\n", "assets", "threads", "serial ms", "critical ms", "all ms", "speedup");
+    for (size_t copies = 1; copies <= 8; copies *= 2) {
+        std::vector<AssetRequest> manifest;
+        for (size_t copy = 0; copy < copies; ++copy)
+            for (const std::string& file : files) manifest.push_back({ file.c_str(), copy == 0 });
+
+        auto start = std::chrono::steady_clock::now();
+        for (const AssetRequest& request : manifest) destroySprite(createSprite(request.path));
+        double serial = millisecondsSince(start);
+
+        AssetLoader loader(threads);
+        loader.start(manifest.data(), manifest.size());
+        loader.wait();
+        AssetLoadStats stats = loader.getStats();
+        if (stats.failed) fprintf(stderr, "%zu assets failed to decode\n", stats.failed);
+
+        printf("%-8zu %8zu %14.2f %14.2f %14.2f %9.1fx\n", manifest.size(), stats.threads, serial, stats.criticalMs, stats.totalMs, serial / stats.criticalMs);
+    }
+    return 0;
+}
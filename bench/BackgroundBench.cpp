@@ -0,0 +1,74 @@
+#include "framework.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Per-frame cost of the static background at common window sizes: compositing
+// the decoded backdrop and score bar every frame (scaled to the window, the
+// score bar blended) against copying the cached, pre-composited layer that
+// drawTestBackground uses. Run from the repository root or pass --material.
+namespace {
+    struct Resolution {
+        const char* name;
+        int width;
+        int height;
+    };
+
+    template <typename Fn>
+    double millisecondsPerFrame(Fn fn) {
+        fn();
+        int frames = 0;
+        auto start = std::chrono::steady_clock::now();
+        double seconds = 0.0;
+        while (seconds < 0.5) {
+            for (int i = 0; i < 10; ++i) fn();
+            frames += 10;
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return seconds * 1e3 / frames;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string material = "material";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--material") == 0 && i + 1 < argc) material = argv[++i];
+    }
+    std::string backdropPath = material + "/backdrop.jpg";
+    std::string scorePath = material + "/score.png";
+
+    Sprite* backdrop = createSprite(backdropPath.c_str());
+    Sprite* score = createSprite(scorePath.c_str());
+    if (!backdrop || !score) { fprintf(stderr, "cannot load %s and %s\n", backdropPath.c_str(), scorePath.c_str()); return 1; }
+    int backdropWidth = backdrop->getWidth(), backdropHeight = backdrop->getHeight();
+
+    const Resolution resolutions[] = {
+        { "600x800", 600, 800 },
+        { "1080p", 1920, 1080 },
+        { "4K", 3840, 2160 },
+    };
+
+    printf("%-10s %16s %16s %10s\n", "size", "composite ms", "cached ms", "speedup");
+    for (const Resolution& r : resolutions) {
+        createFramebuffer(r.width, r.height, nullptr);
+        setBackgroundSprite(backdropPath.c_str());
+        setScoreSprite(scorePath.c_str());
+
+        setSpriteSize(backdrop, r.width, r.height);
+        setSpriteSize(score, r.width, score->getSurface().height);
+        double composite = millisecondsPerFrame([&] {
+            drawSprite(backdrop, 0, 0);
+            drawSprite(score, 0, 0);
+        });
+        double cached = millisecondsPerFrame([] { drawTestBackground(); });
+
+        printf("%-10s %16.3f %16.3f %9.1fx\n", r.name, composite, cached, composite / cached);
+        destroyFramebuffer();
+    }
+
+    setSpriteSize(backdrop, backdropWidth, backdropHeight);
+    destroySprite(backdrop);
+    destroySprite(score);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "framework.h"
+#include "Blitter.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+// Pixel throughput of each blit kernel, for every instruction set the CPU
+// supports, driven through the framework's drawing API into a headless back
+// buffer. The frame checksum after each case must match across instruction
+// sets; the kernels are meant to be bit-identical.
+namespace {
+    constexpr int SCREEN_WIDTH = 800;
+    constexpr int SCREEN_HEIGHT = 600;
+    constexpr int SPRITE_SIZE = 128;
+
+    // Sprite art is mostly fully transparent or fully opaque with a band of
+    // partially transparent edge pixels; mimic that mix.
+    Sprite makeSprite(int width, int height, bool opaque, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float dx = (x + 0.5f) / width - 0.5f, dy = (y + 0.5f) / height - 0.5f;
+                float d = dx * dx + dy * dy;
+                uint32_t a = opaque || d < 0.16f ? 255 : d < 0.22f ? rng() % 255 : 0;
+                uint32_t r = (rng() & 0xFF) * a / 255, g = (rng() & 0xFF) * a / 255, b = (rng() & 0xFF) * a / 255;
+                pixels[static_cast<size_t>(y) * width + x] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+        return Sprite(width, height, std::move(pixels), opaque);
+    }
+
+    uint64_t checksum(const Surface& surface) {
+        uint64_t hash = 1469598103934665603ull;
+        for (int y = 0; y < surface.height; ++y) {
+            const uint32_t* row = surface.row(y);
+            for (int x = 0; x < surface.width; ++x) hash = (hash ^ row[x]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    long long drawnPixels = 0;
+
+    // drawSprite plus a tally of the destination pixels it covers after clipping.
+    void draw(const Sprite* sprite, int x, int y) {
+        int left = x < 0 ? 0 : x, top = y < 0 ? 0 : y;
+        int right = x + sprite->getWidth(), bottom = y + sprite->getHeight();
+        if (right > SCREEN_WIDTH) right = SCREEN_WIDTH;
+        if (bottom > SCREEN_HEIGHT) bottom = SCREEN_HEIGHT;
+        if (right > left && bottom > top) drawnPixels += static_cast<long long>(right - left) * (bottom - top);
+        drawSprite(sprite, x, y);
+    }
+
+    struct Case {
+        const char* name;
+        void (*run)(Sprite& background, Sprite& sprite);
+    };
+
+    void opaqueCopy(Sprite& background, Sprite&) { draw(&background, 0, 0); }
+
+    void alphaBlend(Sprite&, Sprite& sprite) {
+        for (int y = 0; y + SPRITE_SIZE <= SCREEN_HEIGHT; y += 96)
+            for (int x = 0; x + SPRITE_SIZE <= SCREEN_WIDTH; x += 96) draw(&sprite, x, y);
+    }
+
+    // Every sprite straddles a screen edge so half of it is clipped away.
+    void clippedBlend(Sprite&, Sprite& sprite) {
+        for (int i = 0; i < 8; ++i) {
+            int offset = i * 70;
+            draw(&sprite, -SPRITE_SIZE / 2, offset);
+            draw(&sprite, SCREEN_WIDTH - SPRITE_SIZE / 2, offset);
+            draw(&sprite, offset, -SPRITE_SIZE / 2);
+            draw(&sprite, offset + 160, SCREEN_HEIGHT - SPRITE_SIZE / 2);
+        }
+    }
+
+    void scaledBlend(Sprite&, Sprite& sprite) {
+        setSpriteSize(&sprite, SPRITE_SIZE * 3 / 2, SPRITE_SIZE * 3 / 2);
+        for (int y = 0; y + SPRITE_SIZE * 3 / 2 <= SCREEN_HEIGHT; y += 150)
+            for (int x = 0; x + SPRITE_SIZE * 3 / 2 <= SCREEN_WIDTH; x += 150) draw(&sprite, x, y);
+        setSpriteSize(&sprite, SPRITE_SIZE, SPRITE_SIZE);
+    }
+}
+
+int main() {
+    createFramebuffer(SCREEN_WIDTH, SCREEN_HEIGHT, nullptr);
+    Sprite background = makeSprite(SCREEN_WIDTH, SCREEN_HEIGHT, true, 1);
+    Sprite sprite = makeSprite(SPRITE_SIZE, SPRITE_SIZE, false, 2);
+
+    Case cases[] = {
+        { "opaque copy", opaqueCopy },
+        { "alpha blend", alphaBlend },
+        { "clipped blend", clippedBlend },
+        { "scaled blend", scaledBlend },
+    };
+
+    BlitIsa best = getBlitIsa();
+    printf("%-14s %8s %12s %18s\n", "kernel", "isa", "Mpixel/s", "checksum");
+    for (const Case& c : cases) {
+        uint64_t reference = 0;
+        for (int i = 0; i < static_cast<int>(BlitIsa::COUNT); ++i) {
+            BlitIsa isa = static_cast<BlitIsa>(i);
+            if (!isBlitIsaSupported(isa)) continue;
+            setBlitIsa(isa);
+
+            fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0xFF336699);
+            drawnPixels = 0;
+            c.run(background, sprite);
+            long long pixelsPerRun = drawnPixels;
+            uint64_t sum = checksum(*getFramebuffer());
+            if (isa == BlitIsa::Scalar) reference = sum;
+
+            int runs = static_cast<int>(400000000LL / pixelsPerRun);
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < runs; ++r) c.run(background, sprite);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            printf("%-14s %8s %12.0f %18llx%s\n", c.name, getBlitIsaName(isa), static_cast<double>(pixelsPerRun) * runs / seconds / 1e6,
+                static_cast<unsigned long long>(sum), sum == reference ? "" : "  (differs from scalar!)");
+        }
+    }
+    setBlitIsa(best);
+    destroyFramebuffer();
+    return 0;
+}
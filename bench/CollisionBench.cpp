@@ -0,0 +1,110 @@
+#include "EntityStore.h"
+#include "YBucketGrid.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+// Collision cost per tick as entity counts grow: the linear scans World used
+// before (player vs every platform and enemy, every enemy x every projectile)
+// against the YBucketGrid broadphase. Entities are spread over a vertical band
+// that grows with their count, the way a harder difficulty fills the level
+// with more platforms and enemies ahead of the camera.
+namespace {
+    constexpr float ROW_HEIGHT = 64.0f;
+    constexpr float ENTITIES_PER_PIXEL = 0.05f;
+    constexpr int PROJECTILES = 16;
+
+    volatile int sink;
+
+    struct Scene {
+        EntityStore platforms, enemies, projectiles;
+        YBucketGrid platformGrid, enemyGrid;
+        float playerX, playerY, previousY;
+
+        Scene(size_t count, float extent)
+            : platforms(count), enemies(count), projectiles(PROJECTILES)
+            , platformGrid(ROW_HEIGHT, static_cast<size_t>(extent / ROW_HEIGHT) + 1)
+            , enemyGrid(ROW_HEIGHT, static_cast<size_t>(extent / ROW_HEIGHT) + 1)
+            , playerX(300.0f), playerY(extent / 2), previousY(extent / 2 - 8.0f)
+        {
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> x(0.0f, 486.0f), y(0.0f, extent);
+            for (size_t i = 0; i < count; ++i) {
+                float py = y(rng);
+                platformGrid.insert(platforms.create(x(rng), py, 114, 30), py, 30);
+                float ey = y(rng);
+                enemyGrid.insert(enemies.create(x(rng), ey, 129, 172), ey, 172);
+            }
+            std::uniform_real_distribution<float> near(playerY - 400.0f, playerY + 400.0f);
+            for (int i = 0; i < PROJECTILES; ++i) projectiles.create(x(rng), near(rng), 28, 28);
+        }
+    };
+
+    int bruteForce(const Scene& s) {
+        int hits = 0;
+        float bottom = s.playerY + 120, previousBottom = s.previousY + 120;
+        for (size_t i = 0; i < s.platforms.size(); ++i) {
+            if (s.playerX + 74 >= s.platforms.x[i] && s.playerX <= s.platforms.x[i] + s.platforms.width[i]
+                && bottom >= s.platforms.y[i] && previousBottom <= s.platforms.y[i] + 10.0f) ++hits;
+        }
+        for (size_t i = 0; i < s.enemies.size(); ++i) {
+            if (overlaps(s.playerX, s.playerY, 74, 120, s.enemies.x[i], s.enemies.y[i], 50, 50)) ++hits;
+        }
+        for (size_t e = 0; e < s.enemies.size(); ++e) {
+            for (size_t p = 0; p < s.projectiles.size(); ++p) {
+                if (overlaps(s.enemies.x[e], s.enemies.y[e], s.enemies.width[e], s.enemies.height[e],
+                    s.projectiles.x[p], s.projectiles.y[p], 28, 28)) ++hits;
+            }
+        }
+        return hits;
+    }
+
+    int broadphase(const Scene& s) {
+        int hits = 0;
+        float bottom = s.playerY + 120, previousBottom = s.previousY + 120;
+        s.platformGrid.forEachTopInRange(previousBottom - 10.0f, bottom, [&](EntityHandle handle) {
+            size_t i = s.platforms.indexOf(handle);
+            if (s.playerX + 74 >= s.platforms.x[i] && s.playerX <= s.platforms.x[i] + s.platforms.width[i]) ++hits;
+        });
+        s.enemyGrid.forEachTopInRange(s.playerY - 50, s.playerY + 120, [&](EntityHandle handle) {
+            size_t i = s.enemies.indexOf(handle);
+            if (overlaps(s.playerX, s.playerY, 74, 120, s.enemies.x[i], s.enemies.y[i], 50, 50)) ++hits;
+        });
+        for (size_t p = 0; p < s.projectiles.size(); ++p) {
+            s.enemyGrid.forEachOverlapping(s.projectiles.y[p], s.projectiles.y[p] + 28, [&](EntityHandle handle) {
+                size_t e = s.enemies.indexOf(handle);
+                if (overlaps(s.enemies.x[e], s.enemies.y[e], s.enemies.width[e], s.enemies.height[e],
+                    s.projectiles.x[p], s.projectiles.y[p], 28, 28)) ++hits;
+            });
+        }
+        return hits;
+    }
+
+    template <typename Fn>
+    double nanosecondsPerTick(int ticks, Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+    }
+}
+
+int main() {
+    const size_t counts[] = { 10, 100, 1000, 10000, 100000 };
+
+    printf("%10s %14s %18s %9s\n", "entities", "linear ns", "broadphase ns", "speedup");
+    for (size_t count : counts) {
+        Scene scene(count, count / ENTITIES_PER_PIXEL);
+
+        int ticks = static_cast<int>(4000000 / count);
+        if (ticks < 20) ticks = 20;
+        int linearHits = 0, gridHits = 0;
+        double linearNs = nanosecondsPerTick(ticks, [&] { linearHits += bruteForce(scene); });
+        double gridNs = nanosecondsPerTick(ticks, [&] { gridHits += broadphase(scene); });
+
+        printf("%10zu %14.0f %18.0f %8.1fx%s\n", count, linearNs, gridNs, linearNs / gridNs,
+            linearHits == gridHits ? "" : "  (hit counts differ!)");
+        sink = linearHits + gridHits;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "framework.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Full-frame compositing time of the tile compositor at 1..N render threads.
+// Each frame restores the background and draws a scene of opaque, blended,
+// scaled and rotated sprites through beginFrame/endFrame. The checksum must
+// be the same at every thread count.
+namespace {
+    constexpr int SPRITE_SIZE = 96;
+    constexpr int SPRITES_PER_MEGAPIXEL = 150;
+
+    struct Resolution {
+        const char* name;
+        int width;
+        int height;
+    };
+
+    Sprite makeSprite(int width, int height, bool opaque, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float dx = (x + 0.5f) / width - 0.5f, dy = (y + 0.5f) / height - 0.5f;
+                float d = dx * dx + dy * dy;
+                uint32_t a = opaque || d < 0.16f ? 255 : d < 0.22f ? rng() % 255 : 0;
+                uint32_t r = (rng() & 0xFF) * a / 255, g = (rng() & 0xFF) * a / 255, b = (rng() & 0xFF) * a / 255;
+                pixels[static_cast<size_t>(y) * width + x] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+        return Sprite(width, height, std::move(pixels), opaque);
+    }
+
+    uint64_t checksum(const Surface& surface) {
+        uint64_t hash = 1469598103934665603ull;
+        for (int y = 0; y < surface.height; ++y) {
+            const uint32_t* row = surface.row(y);
+            for (int x = 0; x < surface.width; ++x) hash = (hash ^ row[x]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    struct Placement {
+        int kind; // 0 blended, 1 opaque, 2 scaled, 3 rotated
+        int x;
+        int y;
+        float angle;
+    };
+
+    std::vector<Placement> makeScene(int width, int height) {
+        std::mt19937 rng(7);
+        size_t count = static_cast<size_t>(static_cast<long long>(width) * height * SPRITES_PER_MEGAPIXEL / 1000000);
+        std::vector<Placement> scene(count);
+        for (Placement& p : scene) {
+            p.kind = static_cast<int>(rng() % 8);
+            if (p.kind > 3) p.kind = 0;
+            p.x = static_cast<int>(rng() % (width + SPRITE_SIZE)) - SPRITE_SIZE;
+            p.y = static_cast<int>(rng() % (height + SPRITE_SIZE)) - SPRITE_SIZE;
+            p.angle = static_cast<float>(rng() % 360);
+        }
+        return scene;
+    }
+
+    void drawScene(const std::vector<Placement>& scene, Sprite& blended, Sprite& opaque, Sprite& scaled) {
+        invalidateFramebuffer();
+        beginFrame();
+        for (const Placement& p : scene) {
+            switch (p.kind) {
+            case 0: drawSprite(&blended, p.x, p.y); break;
+            case 1: drawSprite(&opaque, p.x, p.y); break;
+            case 2: drawSprite(&scaled, p.x, p.y); break;
+            default: drawSpriteRotated(&blended, p.x, p.y, p.angle); break;
+            }
+        }
+        int count;
+        endFrame(count);
+    }
+}
+
+int main() {
+    const Resolution resolutions[] = {
+        { "1080p", 1920, 1080 },
+        { "4K", 3840, 2160 },
+    };
+    Sprite blended = makeSprite(SPRITE_SIZE, SPRITE_SIZE, false, 1);
+    Sprite opaque = makeSprite(SPRITE_SIZE, SPRITE_SIZE, true, 2);
+    Sprite scaled = makeSprite(SPRITE_SIZE, SPRITE_SIZE, false, 3);
+    setSpriteSize(&scaled, SPRITE_SIZE * 3 / 2, SPRITE_SIZE * 3 / 2);
+
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+    printf("hardware threads: %d\n", maxThreads);
+    printf("%-6s %8s %8s %10s %8s %18s\n", "size", "sprites", "threads", "ms/frame", "speedup", "checksum");
+    for (const Resolution& res : resolutions) {
+        createFramebuffer(res.width, res.height, nullptr);
+        std::vector<Placement> scene = makeScene(res.width, res.height);
+        double baseline = 0.0;
+        uint64_t reference = 0;
+        for (int threads = 1; threads <= maxThreads; threads = threads < maxThreads && threads * 2 > maxThreads ? maxThreads : threads * 2) {
+            setRenderThreads(threads);
+            drawScene(scene, blended, opaque, scaled);
+            uint64_t sum = checksum(*getFramebuffer());
+            if (threads == 1) reference = sum;
+
+            int frames = 0;
+            auto start = std::chrono::steady_clock::now();
+            double seconds = 0.0;
+            while (seconds < 1.0 || frames < 10) {
+                drawScene(scene, blended, opaque, scaled);
+                ++frames;
+                seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            double ms = seconds * 1000.0 / frames;
+            if (threads == 1) baseline = ms;
+            printf("%-6s %8zu %8d %10.3f %7.2fx %18llx%s\n", res.name, scene.size(), threads, ms, baseline / ms,
+                static_cast<unsigned long long>(sum), sum == reference ? "" : "  (differs from 1 thread!)");
+            if (threads == maxThreads) break;
+        }
+        destroyFramebuffer();
+    }
+    setRenderThreads(0);
+    return 0;
+}
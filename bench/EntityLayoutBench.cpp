@@ -0,0 +1,118 @@
+#include "EntityStore.h"
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares one simulation tick (integrate, cull against the view, player
+// collision scan) over the packed EntityStore against the previous layout:
+// vector<unique_ptr<Entity>> with virtual update/render and a sprite map in
+// every entity.
+namespace {
+    constexpr float VIEW_TOP = 0.0f;
+    constexpr float VIEW_BOTTOM = 800.0f;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    volatile float sink;
+
+    namespace legacy {
+        class Entity {
+        protected:
+            float x, y;
+            float velocityX = 0;
+            float velocityY = 0;
+            bool active = true;
+            std::map<std::string, std::shared_ptr<int>> sprites;
+
+        public:
+            Entity(float startX, float startY, const std::shared_ptr<int>& sprite) : x(startX), y(startY) {
+                sprites["100"] = sprite;
+                sprites["75"] = sprite;
+                sprites["25"] = sprite;
+            }
+            virtual ~Entity() = default;
+            virtual void update(float deltaTime) = 0;
+            virtual void render() = 0;
+
+            float getX() const { return x; }
+            float getY() const { return y; }
+            void setVelocity(float vx, float vy) { velocityX = vx; velocityY = vy; }
+        };
+
+        class Mover : public Entity {
+        public:
+            using Entity::Entity;
+            void update(float deltaTime) override { x += velocityX * deltaTime; y += velocityY * deltaTime; }
+            void render() override { if (active && y >= VIEW_TOP && y <= VIEW_BOTTOM) sink = sink + x; }
+        };
+
+        int tick(std::vector<std::unique_ptr<Entity>>& entities, float playerX, float playerY) {
+            for (auto& entity : entities) entity->update(DELTA_TIME);
+            for (auto& entity : entities) entity->render();
+            int hits = 0;
+            for (const auto& entity : entities) {
+                if (overlaps(playerX, playerY, 74, 120, entity->getX(), entity->getY(), 114, 30)) ++hits;
+            }
+            return hits;
+        }
+    }
+
+    int tick(EntityStore& store, float playerX, float playerY) {
+        store.integrate(DELTA_TIME);
+        size_t count = store.size();
+        float visible = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            if (store.isActive(i) && store.y[i] >= VIEW_TOP && store.y[i] <= VIEW_BOTTOM) visible += store.x[i];
+        }
+        sink = visible;
+        int hits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (overlaps(playerX, playerY, 74, 120, store.x[i], store.y[i], store.width[i], store.height[i])) ++hits;
+        }
+        return hits;
+    }
+
+    template <typename Fn>
+    double nanosecondsPerTick(int ticks, Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+    }
+}
+
+int main() {
+    const size_t counts[] = { 10, 1000, 100000 };
+
+    printf("%10s %16s %16s %9s\n", "entities", "legacy ns/tick", "packed ns/tick", "speedup");
+    for (size_t count : counts) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(-4000.0f, 4000.0f);
+        std::uniform_real_distribution<float> velocity(-50.0f, 50.0f);
+        auto sprite = std::make_shared<int>(0);
+
+        std::vector<std::unique_ptr<legacy::Entity>> entities;
+        EntityStore store(count);
+        for (size_t i = 0; i < count; ++i) {
+            float x = position(rng), y = position(rng), vx = velocity(rng), vy = velocity(rng);
+            entities.push_back(std::make_unique<legacy::Mover>(x, y, sprite));
+            entities.back()->setVelocity(vx, vy);
+            size_t index = store.indexOf(store.create(x, y, 114, 30));
+            store.velocityX[index] = vx;
+            store.velocityY[index] = vy;
+        }
+
+        int ticks = static_cast<int>(20000000 / count);
+        if (ticks < 20) ticks = 20;
+        int hits = 0;
+        double legacyNs = nanosecondsPerTick(ticks, [&] { hits += legacy::tick(entities, 300.0f, 400.0f); });
+        double packedNs = nanosecondsPerTick(ticks, [&] { hits += tick(store, 300.0f, 400.0f); });
+
+        printf("%10zu %16.0f %16.0f %8.2fx\n", count, legacyNs, packedNs, legacyNs / packedNs);
+        sink = sink + static_cast<float>(hits);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "FramePacer.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// How closely FramePacer holds a loop to its target and what that costs in
+// CPU. Each mode runs a fake frame of WORK_MS busy work for SECONDS, then
+// reports the measured intervals and the share of one core the process used.
+namespace {
+    constexpr double WORK_MS = 2.0;
+    constexpr double SECONDS = 3.0;
+
+    double cpuSeconds() {
+#ifdef _WIN32
+        FILETIME created, exited, kernel, user;
+        GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user);
+        auto toSeconds = [](const FILETIME& t) { return ((static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime) / 1e7; };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    void busyWork() {
+        auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(static_cast<long long>(WORK_MS * 1000));
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+}
+
+int main() {
+    const int modes[] = { 30, 60, 144, 0 };
+
+    printf("%-9s %8s %9s %10s %12s %12s %8s\n", "target", "frames", "mean ms", "jitter ms", "p99 err ms", "max err ms", "cpu %");
+    for (int fps : modes) {
+        FramePacer pacer(fps);
+        double cpuStart = cpuSeconds();
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        while (elapsed < SECONDS) {
+            busyWork();
+            pacer.wait();
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        double cpu = (cpuSeconds() - cpuStart) / elapsed * 100.0;
+
+        FramePacingStats stats = pacer.getStats();
+        char name[16];
+        if (fps) snprintf(name, sizeof(name), "%d fps", fps);
+        else snprintf(name, sizeof(name), "uncapped");
+        printf("%-9s %8zu %9.3f %10.3f %12.3f %12.3f %7.1f%%\n", name, stats.frames, stats.meanMs, stats.jitterMs, stats.p99ErrorMs, stats.maxErrorMs, cpu);
+    }
+    return 0;
+}
@@ -1,47 +1,85 @@
 #include "GameManager.h"
+#include "FramePacer.h"
+#include "Profiler.h"
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
+
+namespace {
+    // Everything the client draws. The first frame needs the background, the
+    // player on its platforms and the counters; enemies and shots only show
+    // up once the game is under way.
+    const AssetRequest ASSET_MANIFEST[] = {
+        { "material/backdrop.jpg", true },
+        { "material/score.png", true },
+        { "material/leftup.png", true },
+        { "material/leftdown.png", true },
+        { "material/rightup.png", true },
+        { "material/rightdown.png", true },
+        { "material/upup.png", true },
+        { "material/updown.png", true },
+        { "material/nose.png", true },
+        { "material/100.png", true },
+        { "material/75.png", true },
+        { "material/25.png", true },
+        { "material/0.png", true },
+        { "material/1.png", true },
+        { "material/2.png", true },
+        { "material/3.png", true },
+        { "material/4.png", true },
+        { "material/5.png", true },
+        { "material/6.png", true },
+        { "material/7.png", true },
+        { "material/8.png", true },
+        { "material/9.png", true },
+        { "material/monst1.png", false },
+        { "material/monst2.png", false },
+        { "material/monst3.png", false },
+        { "material/projectile.png", false },
+    };
+}
 
 GameManager::GameManager(const GameConfig& cfg)
     : config(cfg)
-    , resources(ResourceManager::getInstance())
-    , mouseX(0)
-    , mouseY(0)
-    , playerCenterX(0)
-    , playerCenterY(0)
-    , dirX(0)
-    , dirY(0)
-    , velocityX(0)
-    , velocityY(0)
-    , lastShotTime(std::chrono::steady_clock::now())
-    , score(0)
-    , shift(0.0f)
-    , gameOver(false)
-    , deltaTime(0)
-    , lastFrameTime(std::chrono::steady_clock::now())
-    , highestPlatformY(450)
-    , lastJumpedPlatformId(-1)
-    , platformIdCounter(0)
     , screenWidth(0)
     , screenHeight(0)
+    , gameOverShown(false)
+    , resources(ResourceManager::getInstance())
+    , assetsReady(false)
+    , firstFrameShown(false)
+    , renderedCameraY(0.0f)
+    , shownTick(0)
+    , frameIndex(0)
+    , stopRequested(false)
+    , simulationDone(false)
+    , droppedInput(0)
+    , liveInput(false)
+    , tick(0)
+    , recordingSession(!cfg.recordPath.empty())
+    , replaying(!cfg.replayPath.empty())
+    , replayFailed(false)
 {
-    try {
-        if (Gdiplus::GdiplusStartup(&gdiplusToken, &gdiplusStartupInput, NULL) != Gdiplus::Ok) throw std::runtime_error("Failed to initialize GDI+");
-       
-        platforms.reserve(GameConstants::INITIAL_PLATFORM_COUNT);
-        enemies.reserve(GameConstants::INITIAL_PLATFORM_COUNT / 2);
-        projectiles.reserve(10);
-        jetpacks.reserve(5);
-
+    if (replaying) {
+        if (!replay.load(config.replayPath.c_str())) throw std::runtime_error("Failed to read recording " + config.replayPath);
+        // The recording decides everything that shapes the simulation.
+        replay.applyTo(config);
+        replayCursor = std::make_unique<ReplayCursor>(replay);
     }
-    catch (const std::exception& e) {
-        printf("Error in GameManager constructor: %s\n", e.what());
-        cleanup(); throw;
+    // A replay already says what the player did, so it wins over an agent.
+    else if (!config.agent.empty()) {
+        agent = createAgent(config.agent, config);
+        if (!agent) throw std::runtime_error("Unknown agent " + config.agent);
+        agentInput.reserve(MAX_ACTION_EVENTS);
     }
+    liveInput = !replaying && !agent;
+    stepSeconds = FixedTimestep(config.tickRate).getStep();
+    // Replays always collect frame times so runs can be compared.
+    Profiler::setEnabled(config.debugMode || replaying);
 }
 
 GameManager::~GameManager() {
-    try { cleanup(); Gdiplus::GdiplusShutdown(gdiplusToken); }
+    try { cleanup(); }
     catch (...) {}
 }
 
@@ -51,332 +89,367 @@ void GameManager::PreInit(int& width, int& height, bool& fullscreen) {
     fullscreen = config.fullscreen;
 }
 
-bool GameManager::Init() { resetGame(); return true; }
-
-void GameManager::Close() { cleanup(); }
-
-void GameManager::showGameOverScreen() {
-    HDC hDC = getHDC();
-
-    RECT rect = { 0, 0, screenWidth, screenHeight };
-    FillRect(hDC, &rect, (HBRUSH)GetStockObject(BLACK_BRUSH));
-
-    drawSprite(getGameScoreSprite(), 0, screenHeight / 2 - 10);
-    drawSprite(getGameScoreSprite(), 0, screenHeight / 2 - 77);
-
-    drawNumber(score, (screenWidth - 100) / 2, screenHeight / 2 - 50);
-    drawNumber(player->getPlatformsCount(), (screenWidth - 100) / 2, screenHeight / 2);
-}
-
-bool GameManager::Tick() {
-    if (gameOver) {
-        showGameOverScreen();
-        auto currentTime = std::chrono::steady_clock::now();
-        float elapsedSeconds = std::chrono::duration<float>(currentTime - gameOverTime).count();
-        if (elapsedSeconds >= 2.0f) { resetGame(); gameOver = false; }
-        return false;
+bool GameManager::Init() {
+    // Decoding runs on the loader's workers; only the critical set holds up
+    // the first frame, the rest is picked up by Tick as it lands.
+    initStart = std::chrono::steady_clock::now();
+    if (!config.assetArchive.empty()) {
+        bool mounted = mountAssetArchive(config.assetArchive.c_str());
+        if (config.debugMode) printf(mounted ? "Sprites mapped from %s\n" : "No usable archive at %s, decoding loose files\n", config.assetArchive.c_str());
     }
-    updateDeltaTime();
+    assets.start(ASSET_MANIFEST, std::size(ASSET_MANIFEST));
+    assets.waitForCritical();
+    assets.publish(resources);
+    bindSprites();
+    if (backdropSprite && scoreBarSprite) setBackgroundLayers(backdropSprite.get(), scoreBarSprite.get());
+    getScreenSize(screenWidth, screenHeight);
+    world = std::make_unique<World>(config, screenWidth, screenHeight);
+    if (recordingSession) recording.begin(config, screenWidth, screenHeight);
+    sessionStart = std::chrono::steady_clock::now();
+
+    captureSnapshot(*world, tick, snapshots.writeBuffer());
+    snapshots.publish();
+    simulationThread = std::thread(&GameManager::runSimulation, this);
+    return true;
+}
 
-    for (auto& platform : platforms) {
-        platform->update(deltaTime);
-        platform->render();
+void GameManager::Close() {
+    stopSimulation();
+    if (recordingSession && world) {
+        recording.finish(tick, *world);
+        if (recording.save(config.recordPath.c_str())) printf("Recorded %zu input events to %s\n", recording.events.size(), config.recordPath.c_str());
+        else printf("Failed to write recording %s\n", config.recordPath.c_str());
     }
-
-    for (auto& projectile : projectiles) projectile->render();
-    for (auto& enemy : enemies) enemy->render();
-    
-    if (player) {
-        player->update(deltaTime);
-        player->render();
-        drawNumber(player->getPlatformsCount(), 20, 20);
-        drawNumber(score, config.windowWidth - 100, 20);
+    if (config.debugMode) {
+        const ResourceStats& stats = resources.getStats();
+        printf("Sprite cache: %zu sprites, %zu hits, %zu misses, %zu bytes resident\n",
+            resources.getSpriteCount(), stats.hits, stats.misses, stats.bytesResident);
+        if (world) {
+            printPoolStats("Platform", world->getPlatformPoolStats());
+            printPoolStats("Enemy", world->getEnemyPoolStats());
+            printPoolStats("Projectile", world->getProjectilePoolStats());
+            const LevelStreamStats& level = world->getLevelStats();
+            printf("Level chunks: %llu streamed, %llu generated in the step, %llu discarded\n", static_cast<unsigned long long>(level.streamed),
+                static_cast<unsigned long long>(level.generated), static_cast<unsigned long long>(level.discarded));
+        }
+        if (liveInput) {
+            InputLatencyStats latency = inputLatency.getStats();
+            printf("Input to present: %zu events (%zu dropped), p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+                latency.events, latency.dropped, latency.p50Ms, latency.p95Ms, latency.p99Ms, latency.maxMs);
+            printf("Input queue: %zu events lost while full\n", droppedInput);
+            if (inputLatency.writeHistogram(LATENCY_HISTOGRAM_PATH) && inputLatency.writeSamples(LATENCY_SAMPLES_PATH))
+                printf("Input latency written to %s and %s\n", LATENCY_HISTOGRAM_PATH, LATENCY_SAMPLES_PATH);
+        }
+        FrameArenaStats arena = getFrameArena().getStats();
+        printf("Frame arena: capacity %zu, high water %zu, overflows %zu\n", arena.capacity, arena.highWater, arena.overflows);
+        Profiler::printSummary();
+        if (Profiler::writeChromeTrace(TRACE_PATH)) printf("Trace written to %s\n", TRACE_PATH);
     }
-
-    updateEntities();
-    handleCollisions();
-
-    platforms.erase(std::remove_if(platforms.begin(), platforms.end(),
-        [](const auto& p) { return !p->isActive(); }), platforms.end());
-
-    while (platforms.size() < GameConstants::INITIAL_PLATFORM_COUNT) spawnPlatform();
-    return false;
+    cleanup();
 }
 
-void GameManager::updateDeltaTime() {
-    auto currentTime = std::chrono::steady_clock::now();
-    deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
-    deltaTime = min(deltaTime, 0.016f);
-    lastFrameTime = currentTime;
+void GameManager::printPoolStats(const char* name, const PoolStats& stats) {
+    printf("%s pool: capacity %zu, high water %zu, exhausted %zu\n", name, stats.capacity, stats.highWater, stats.exhausted);
 }
 
-void GameManager::spawnPlatform() {
-    float x = static_cast<float>(rand() % (config.windowWidth - GameConstants::PLATFORM_WIDTH));
-    float y = static_cast<float>(highestPlatformY - GameConstants::MIN_PLATFORM_INTERVAL);
+// Frames never hit the disk: sprites come from the cache once the loader has
+// published them, and ones still decoding stay null until the next call.
+void GameManager::bindSprites() {
+    backdropSprite = resources.findSprite("material/backdrop.jpg");
+    scoreBarSprite = resources.findSprite("material/score.png");
 
-    auto platform = std::make_unique<Platform>(x, y, ++platformIdCounter);
-    if (platformIdCounter > GameConstants::INITIAL_PLATFORM_COUNT && !platform->getDisappearing()) {
-        if ((rand() % 100) < GameConstants::ENEMY_SPAWN_CHANCE) {
-            platform->setHasEnemy(true);
-            int enemyType = rand() % 3;
-            auto enemy = std::make_unique<Enemy>(0, 0, enemyType);
+    for (size_t pose = 0; pose < std::size(playerSprites); ++pose) playerSprites[pose] = resources.findSprite(animation::PLAYER_POSES[pose].sprite);
+    noseSprite = resources.findSprite("material/nose.png");
 
-            float enemyX = x + (GameConstants::PLATFORM_WIDTH - enemy->getWidth()) / 2;
-            float enemyY = y - enemy->getHeight();
+    for (size_t variant = 0; variant < std::size(platformSprites); ++variant) platformSprites[variant] = resources.findSprite(animation::PLATFORM_SPRITES[variant]);
 
-            enemy->setPosition(enemyX, enemyY);
-            enemies.push_back(std::move(enemy));
-        }
-    }
+    enemySprites[0] = resources.findSprite("material/monst1.png");
+    enemySprites[1] = resources.findSprite("material/monst2.png");
+    enemySprites[2] = resources.findSprite("material/monst3.png");
 
-    platforms.push_back(std::move(platform));
-    highestPlatformY = static_cast<int>(y);
-}
+    projectileSprite = resources.findSprite("material/projectile.png");
 
-void GameManager::updateEntities() {
-    if (!player) return;
-    updatePlayer();
-    updatePlatforms();
-    updateProjectiles();
-    updateEnemies();
+    for (int i = 0; i < 10; i++) {
+        std::string filePath = "material/" + std::to_string(i) + ".png"; digits[i] = resources.findSprite(filePath.c_str());
+    }
 }
 
-void GameManager::updatePlayer() {
-    player->update(deltaTime);
-    player->setLookingUp(cooldown());
-
-    getScreenSize(screenWidth, screenHeight);
-
-    if (player->getY() > screenHeight) { gameOver = true; gameOverTime = std::chrono::steady_clock::now(); return; }
-
-    if (player->getY() < screenHeight / 2) {
-        shift = screenHeight / 2 - player->getY();
-        player->setPosition(player->getX(), screenHeight / 2);
-
-        for (auto& platform : platforms) platform->setPosition(platform->getX(), platform->getY() + shift);
-        for (auto& enemy : enemies) enemy->setPosition(enemy->getX(), enemy->getY() + shift);
-        
-        highestPlatformY += static_cast<int>(shift);
-        score += static_cast<int>(shift * 0.5f);
+void GameManager::pollAssets() {
+    if (assets.publish(resources)) bindSprites();
+    if (!assets.isComplete()) return;
+    assetsReady = true;
+    if (config.debugMode) {
+        AssetLoadStats stats = assets.getStats();
+        printf("Assets: %zu decoded on %zu threads (%zu failed, %zu bytes); critical set %.1f ms, all %.1f ms, %.1f ms decode time\n",
+            stats.assets, stats.threads, stats.failed, stats.bytes, stats.criticalMs, stats.totalMs, stats.decodeMs);
     }
 }
 
-void GameManager::updatePlatforms() {
-    for (auto& platform : platforms) platform->update(deltaTime);
-    getScreenSize(screenWidth, screenHeight);
+void GameManager::showGameOverScreen(const RenderSnapshot& snapshot) {
+    DJ_PROFILE_ZONE("showGameOverScreen");
+    fillRect(0, 0, screenWidth, screenHeight, 0xFF000000);
 
-    platforms.erase(
-        std::remove_if(platforms.begin(), platforms.end(),
-            [this](const auto& platform) { return platform->getY() > screenHeight || !platform->isActive(); }),
-        platforms.end());
+    drawSprite(getGameScoreSprite(), 0, screenHeight / 2 - 10);
+    drawSprite(getGameScoreSprite(), 0, screenHeight / 2 - 77);
 
-    while (platforms.size() < GameConstants::INITIAL_PLATFORM_COUNT) spawnPlatform();
+    drawNumber(snapshot.score, (screenWidth - 100) / 2, screenHeight / 2 - 50);
+    drawNumber(snapshot.platformsCount, (screenWidth - 100) / 2, screenHeight / 2);
 }
 
-void GameManager::handleCollisions() {
-    if (!player) return;
-
-    float playerBottom = player->getY() + GameConstants::PLAYER_HEIGHT;
-    float playerLeft = player->getX();
-    float playerRight = player->getX() + GameConstants::PLAYER_WIDTH;
-
-    int currentPlatformId = -1;
-
-    for (const auto& platform : platforms) {
-        float platformTop = platform->getY();
-        float platformBottom = platformTop + GameConstants::PLATFORM_HEIGHT;
-        float platformLeft = platform->getX();
-        float platformRight = platform->getX() + GameConstants::PLATFORM_WIDTH;
-
-        if (playerRight >= platformLeft && playerLeft <= platformRight) {
-            if (playerBottom >= platformTop && playerBottom <= platformTop + 10.0f && player->getVelocityY() > 0) {
-                player->setPosition(player->getX(), platformTop - GameConstants::PLAYER_HEIGHT);
-                player->setVelocityY(0);
-                player->jump();
-                currentPlatformId = platform->getId();
-                if (currentPlatformId != player->getLastJumpedPlatformId()) { player->updatePlatformCount(); player->setLastJumpedPlatformId(currentPlatformId); }
-                break;
-            }
-        }
+// The window thread only draws: it picks up the newest snapshot the
+// simulation published and interpolates from the step before it.
+bool GameManager::Tick() {
+    if (simulationDone.load(std::memory_order_acquire)) {
+        stopSimulation();
+        return endReplay();
     }
 
-    for (const auto& enemy : enemies) {
-        if (enemy->isActive() &&
-            player->collidesWith(*enemy,
-                GameConstants::PLAYER_WIDTH,
-                GameConstants::PLAYER_HEIGHT,
-                GameConstants::ENEMY_WIDTH,
-                GameConstants::ENEMY_HEIGHT)) {
-            gameOver = true;
-            gameOverTime = std::chrono::steady_clock::now();
-            return;
-        }
+    if (!assetsReady) pollAssets();
+    if (!firstFrameShown) {
+        firstFrameShown = true;
+        if (config.debugMode) printf("First frame after %.1f ms\n",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - initStart).count());
     }
+
+    snapshots.update();
+    const RenderSnapshot& snapshot = snapshots.readBuffer();
+    shownTick = snapshot.tick;
+    ++frameIndex;
+    if (snapshot.gameOver) showGameOverScreen(snapshot);
+    else render(snapshot, interpolationAlpha(snapshot));
+    return false;
 }
 
-void GameManager::drawNumber(int number, int x, int y) {
-    std::string numberStr = std::to_string(number);
-    int xOffset = 0;
-    for (size_t i = 0; i < numberStr.length(); ++i) {
-        int digitIndex = numberStr[i] - '0';
-        drawSprite(player->getDigit(digitIndex), x + xOffset, y);
-        xOffset += 20;
-    }
+// How far real time has moved past the snapshot's step, in steps. Rendering
+// runs up to one step behind the simulation in exchange for smooth motion.
+float GameManager::interpolationAlpha(const RenderSnapshot& snapshot) const {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    if (now <= snapshot.publishedNs) return 0.0f;
+    float alpha = static_cast<float>((now - snapshot.publishedNs) / 1e9 / stepSeconds);
+    return std::min(alpha, 1.0f);
 }
 
-void GameManager::cleanup() {
-    try {
-        if (player) player.reset();
-        platforms.clear();
-        enemies.clear();
-        projectiles.clear();
-        jetpacks.clear();
+// Fixed-rate loop on its own thread: one step per tick, held to real time by
+// a FramePacer, so a slow frame on the window thread never stretches the
+// simulation. Returns when stopped or when the replay has run out.
+void GameManager::runSimulation() {
+    FramePacer pacer(FixedTimestep(config.tickRate).getTickRate());
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        bool more = simulateTick();
+        captureSnapshot(*world, tick, snapshots.writeBuffer());
+        snapshots.publish();
+        if (!more) { simulationDone.store(true, std::memory_order_release); return; }
+        pacer.wait();
     }
-    catch (...) {}
 }
 
-void GameManager::resetGame() {
-    cleanup();
-
-    score = 0;
-    gameOver = false;
-    highestPlatformY = config.windowHeight - 65;
-    lastJumpedPlatformId = -1;
-    platformIdCounter = 0;
-
-    float startPlatformX = config.windowWidth / 2.0f - GameConstants::PLATFORM_WIDTH / 2.0f;
-    float startPlatformY = config.windowHeight - 65.0f;
-    platforms.push_back(std::make_unique<Platform>(startPlatformX, startPlatformY, ++platformIdCounter));
+bool GameManager::simulateTick() {
+    DJ_PROFILE_ZONE("simulateTick");
+    // Window input lands here and nowhere else; its effect is first drawn
+    // from the snapshot published after this step.
+    TimedInputEvent input;
+    while (inputQueue.pop(input)) {
+        if (!world->isGameOver()) inputLatency.applied(input, tick + 1);
+        dispatchInput(input.event);
+    }
+    if (replaying) deliverReplay();
+
+    if (world->isGameOver()) {
+        // Replays restart when the recording says the player did.
+        if (replaying) return !replayCursor->isFinished(tick);
+        auto now = std::chrono::steady_clock::now();
+        if (!gameOverShown) { gameOverShown = true; gameOverTime = now; }
+        else if (std::chrono::duration<float>(now - gameOverTime).count() >= 2.0f) restartGame();
+        return true;
+    }
+    if (replaying && replayCursor->isFinished(tick)) return false;
+    if (agent) deliverAgentInput();
+
+    world->step(stepSeconds);
+    ++tick;
+    if (recordingSession) recording.afterStep(tick, *world);
+    if (replaying && !replayCursor->afterStep(tick, *world)) { replayFailed = true; return false; }
+    return true;
+}
 
-    player = std::make_unique<Player>(
-        startPlatformX + (GameConstants::PLATFORM_WIDTH - GameConstants::PLAYER_WIDTH) / 2.0f,
-        startPlatformY - GameConstants::PLAYER_HEIGHT -150.0f,
-        config);
+void GameManager::stopSimulation() {
+    stopRequested.store(true, std::memory_order_release);
+    if (simulationThread.joinable()) simulationThread.join();
+}
 
-    for (int i = 0; i < 10; i++) {
-        std::string filePath = "material/" + std::to_string(i) + ".png";
-        player->setDigit(i, createSprite(filePath.c_str()));
+void GameManager::restartGame() {
+    if (recordingSession) {
+        InputEvent event;
+        event.type = InputEventType::GameReset;
+        dispatchInput(event);
     }
+    world->reset();
+    gameOverShown = false;
+}
 
-    for (int i = 1; i < GameConstants::INITIAL_PLATFORM_COUNT; ++i) spawnPlatform();
-    enemies.clear();
+void GameManager::dispatchInput(InputEvent event) {
+    event.tick = tick;
+    event.timeMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - sessionStart).count());
+    if (recordingSession) recording.record(event);
+    translator.apply(event, *world);
 }
 
-bool GameManager::cooldown() {
-    auto currentTime = std::chrono::steady_clock::now();
-    float elapsedMs = std::chrono::duration<float, std::milli>(currentTime - lastShotTime).count();
-    return elapsedMs < GameConstants::PROJECTILE_COOLDOWN;
+// Generated input (replay, agents) takes the same path as the window's once
+// it reaches the simulation thread.
+void GameManager::injectInput(const InputEvent& event) {
+    if (event.type == InputEventType::GameReset) restartGame();
+    else dispatchInput(event);
 }
 
-void GameManager::onMouseMove(int x, int y, int xrelative, int yrelative) { mouseX = x; mouseY = y; }
-void GameManager::onMouseButtonClick(FRMouseButton button, bool isReleased) {
-    if (!player || isReleased) return;
-    if (button == FRMouseButton::LEFT) {
-        if (!cooldown()) {
-            player->setLookingUp(false);
+void GameManager::deliverReplay() {
+    replayCursor->deliver(tick, [this](const InputEvent& event) { injectInput(event); });
+}
 
-            playerCenterX = player->getX() + GameConstants::PLAYER_WIDTH / 2;
-            playerCenterY = player->getY() + GameConstants::PLAYER_HEIGHT / 2;
+// Agents act once per step, like the headless runner, so the windowed game
+// plays the same way only paced to real time.
+void GameManager::deliverAgentInput() {
+    agentInput.clear();
+    observe(*world, tick, observation);
+    appendActionEvents(agent->act(observation), *world, agentInput);
+    for (const InputEvent& event : agentInput) injectInput(event);
+}
 
-            float dx = mouseX - playerCenterX;
-            float dy = mouseY - playerCenterY;
-            float length = sqrt(dx * dx + dy * dy);
+bool GameManager::endReplay() {
+    if (!replayCursor->hasDiverged()) replayCursor->finish(tick, *world);
+    Profiler::FrameStats frames = Profiler::getFrameStats();
+    if (replayCursor->hasDiverged()) {
+        replayFailed = true;
+        fprintf(stderr, "REPLAY DIVERGED: %s\n", replayCursor->getError().c_str());
+        printf("REPLAY DIVERGED: %s\n", replayCursor->getError().c_str());
+    }
+    else printf("Replay matched: %u ticks, final score %d\n", tick, world->getScore());
+    printf("Frames: %zu, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n", frames.frames, frames.p50Ms, frames.p95Ms, frames.p99Ms, frames.maxMs);
+    return true;
+}
 
-            float angle = atan2(dx, -dy) * 180.0f / 3.14159f;
-            angle = max(-90.0f, min(90.0f, angle));
+// World coordinates become screen coordinates by subtracting the camera; the
+// same transform decides what is culled.
+void GameManager::render(const RenderSnapshot& snapshot, float alpha) {
+    DJ_PROFILE_ZONE("render");
+    float cameraY = snapshot.interpolatedCameraY(alpha);
+    // A scroll moves every sprite on screen; skip the damage tracking.
+    if (cameraY != renderedCameraY) invalidateFramebuffer();
+    renderedCameraY = cameraY;
+
+    for (const SnapshotEntity& platform : snapshot.platforms) {
+        const Sprite* sprite = platformSprites[static_cast<size_t>(animation::platformVariant(platform.value))].get();
+        drawWorldSprite(sprite, platform.interpolatedX(alpha), platform.interpolatedY(alpha) - cameraY);
+    }
 
-            player->setNoseAngle(angle);
+    for (const SnapshotEntity& projectile : snapshot.projectiles)
+        drawWorldSprite(projectileSprite.get(), projectile.interpolatedX(alpha), projectile.interpolatedY(alpha) - cameraY);
 
-            dirX = dx / length;
-            dirY = dy / length;
+    for (const SnapshotEntity& enemy : snapshot.enemies)
+        drawWorldSprite(enemySprites[enemy.variant].get(), enemy.interpolatedX(alpha), enemy.interpolatedY(alpha) - cameraY);
 
-            velocityX = dirX * GameConstants::PROJECTILE_SPEED;
-            velocityY = dirY * GameConstants::PROJECTILE_SPEED;
+    if (snapshot.hasPlayer) {
+        renderPlayer(snapshot, alpha, cameraY);
+        drawNumber(snapshot.platformsCount, 20, 20);
+        drawNumber(snapshot.score, config.windowWidth - 100, 20);
+    }
+    if (config.debugMode) renderDebugOverlay();
+}
 
-            auto projectile = std::make_unique<Projectile>(playerCenterX, playerCenterY, atan2(dirY, dirX));
+// Bottom left: the frame arena's high-water mark in KB over a bar showing it
+// against the arena's capacity; the bar turns red once a frame overflowed.
+void GameManager::renderDebugOverlay() {
+    FrameArenaStats arena = getFrameArena().getStats();
+    int barWidth = 100;
+    int used = arena.capacity ? static_cast<int>(barWidth * arena.highWater / arena.capacity) : 0;
+    fillRect(20, screenHeight - 16, barWidth, 6, 0xFF404040);
+    fillRect(20, screenHeight - 16, std::max(used, 1), 6, arena.overflows ? 0xFFD03030 : 0xFF30C050);
+    drawNumber(static_cast<int>((arena.highWater + 1023) / 1024), 20, screenHeight - 50);
+}
 
-            projectile->setVelocityX(velocityX);
-            projectile->setVelocityY(velocityY);
-            projectiles.push_back(std::move(projectile));
-            lastShotTime = std::chrono::steady_clock::now();
-        }
-    }
+void GameManager::drawWorldSprite(const Sprite* sprite, float screenX, float screenY) {
+    if (!sprite || screenY > screenHeight || screenY + sprite->getHeight() < 0) return;
+    drawSprite(sprite, static_cast<int>(screenX), static_cast<int>(screenY));
 }
 
-void GameManager::onKeyPressed(FRKey k) {
-    if (!player) return;
-    switch (k) {
-    case FRKey::LEFT: player->moveLeft(); break;
-    case FRKey::RIGHT: player->moveRight(); break;
+void GameManager::renderPlayer(const RenderSnapshot& snapshot, float alpha, float cameraY) {
+    size_t pose = static_cast<size_t>(animation::playerPose(snapshot));
+    const animation::PoseInfo& info = animation::PLAYER_POSES[pose];
+    const Sprite* currentSprite = playerSprites[pose].get();
+    if (!currentSprite) return;
+
+    float playerX = snapshot.player.interpolatedX(alpha);
+    float playerY = snapshot.player.interpolatedY(alpha) - cameraY;
+    drawSprite(currentSprite, static_cast<int>(playerX), static_cast<int>(playerY));
+    if (info.nose && noseSprite) {
+        float noseX = playerX + (GameConstants::PLAYER_FULL_WIDTH - 28) / 2 - 3;
+        float noseY = playerY + 3 + info.noseOffsetY;
+        drawSpriteRotated(noseSprite.get(),
+            static_cast<int>(noseX),
+            static_cast<int>(noseY),
+            snapshot.noseAngle);
     }
 }
 
-void GameManager::onKeyReleased(FRKey k) {
-    if (!player) return;
-    switch (k) {
-    case FRKey::LEFT: if (player->getVelocityX() < 0) player->stop(); break;
-    case FRKey::RIGHT: if (player->getVelocityX() > 0) player->stop(); break;
-    }
+void GameManager::drawNumber(int number, int x, int y) {
+    DJ_PROFILE_ZONE("drawNumber");
+    // Digits come out least significant first; they are drawn right to left.
+    unsigned value = number < 0 ? 0u : static_cast<unsigned>(number);
+    int digitValues[10];
+    int count = 0;
+    do {
+        digitValues[count++] = static_cast<int>(value % 10);
+        value /= 10;
+    } while (value);
+    for (int i = 0; i < count; ++i) drawSprite(digits[digitValues[count - 1 - i]].get(), x + i * 20, y);
 }
 
-void GameManager::spawnProjectile(float x, float y, float angle) {
-    projectiles.push_back(std::make_unique<Projectile>(x + GameConstants::PLAYER_FULL_WIDTH / 2, y, angle));
+void GameManager::cleanup() {
+    stopSimulation();
+    try { world.reset(); }
+    catch (...) {}
 }
 
-void GameManager::updateProjectiles() {
-    for (auto& projectile : projectiles) projectile->update(deltaTime);
-    projectiles.erase(
-        std::remove_if(projectiles.begin(), projectiles.end(),
-            [](const auto& p) { return !p->isActive(); }), projectiles.end());
+void GameManager::onMouseMove(int x, int y, int /*xrelative*/, int /*yrelative*/) {
+    if (!liveInput) return;
+    InputEvent event;
+    event.type = InputEventType::MouseMove;
+    event.x = x;
+    event.y = y;
+    queueInput(event);
 }
 
-void GameManager::spawnEnemy() {
-    if (platforms.size() < 2) return;
-    if ((rand() % 100) >= GameConstants::ENEMY_SPAWN_CHANCE) return;
+void GameManager::onMouseButtonClick(FRMouseButton button, bool isReleased) {
+    if (!liveInput) return;
+    InputEvent event;
+    event.type = InputEventType::MouseButton;
+    event.code = static_cast<uint8_t>(button);
+    event.released = isReleased;
+    queueInput(event);
+}
 
-    int index = 1 + (rand() % (platforms.size() - 1));
-    auto& platform = platforms[index];
+void GameManager::onKeyPressed(FRKey k) {
+    if (!liveInput) return;
+    InputEvent event;
+    event.type = InputEventType::KeyPressed;
+    event.code = static_cast<uint8_t>(k);
+    queueInput(event);
+}
 
-    float platformX = platform->getX();
-    float platformY = platform->getY();
+void GameManager::onKeyReleased(FRKey k) {
+    if (!liveInput) return;
+    InputEvent event;
+    event.type = InputEventType::KeyReleased;
+    event.code = static_cast<uint8_t>(k);
+    queueInput(event);
+}
 
-    for (const auto& enemy : enemies) {
-        if (abs(enemy->getY() + enemy->getHeight() - platformY) < 5.0f &&
-            abs(enemy->getX() - platformX) < GameConstants::PLATFORM_WIDTH) return;
-    }
+void GameManager::queueInput(const InputEvent& event) {
+    if (!inputQueue.push({ event, InputLatencyTracker::now() })) ++droppedInput;
+}
 
-    int enemyType = rand() % 3;
-    auto enemy = std::make_unique<Enemy>(0, 0, enemyType);
-
-    float enemyX = platform->getX() + (GameConstants::PLATFORM_WIDTH - enemy->getWidth()) / 2;
-    float enemyY = platform->getY() - enemy->getHeight();
-
-    enemy->setPosition(enemyX, enemyY);
-    enemies.push_back(std::move(enemy));
-}
-
-void GameManager::updateEnemies() {
-    for (auto& enemy : enemies) enemy->update(deltaTime);
-    
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [](const auto& e) { return !e->isActive(); }
-        ), enemies.end());
-
-    for (auto& enemy : enemies) {
-        for (auto& projectile : projectiles) {
-            if (enemy->isActive() && projectile->isActive() &&
-                enemy->collidesWith(*projectile,
-                    enemy->getWidth(),
-                    enemy->getHeight(),
-                    GameConstants::PROJECTILE_WIDTH,
-                    GameConstants::PROJECTILE_HEIGHT)) {
-                enemy->setActive(false);
-                projectile->setActive(false);
-                score += 100;
-            }
-        }
-    }
+void GameManager::onFramePresented() {
+    if (liveInput) inputLatency.presented(shownTick, frameIndex, InputLatencyTracker::now());
 }
 
-const char* GameManager::GetTitle() { return "Doodle Jump"; }
\ No newline at end of file
+const char* GameManager::GetTitle() { return "Doodle Jump"; }
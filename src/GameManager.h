@@ -1,41 +1,82 @@
 #pragma once
-#include "Entity.h"
+#include "World.h"
+#include "Agent.h"
+#include "Animation.h"
+#include "AssetLoader.h"
+#include "FixedTimestep.h"
 #include "GameConfig.h"
+#include "InputLatency.h"
+#include "InputRecording.h"
+#include "RenderSnapshot.h"
 #include "ResourceManager.h"
-#include <vector>
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include <atomic>
 #include <memory>
+#include <string>
 #include <chrono>
+#include <thread>
 
+// Client for the simulation. The World runs on its own thread at the fixed
+// tick rate and publishes a RenderSnapshot after every step; the window
+// thread forwards input through a queue and draws the newest snapshot into
+// the framework's back buffer each frame.
 class GameManager : public Framework {
 private:
+    static constexpr const char* TRACE_PATH = "doodle_trace.json";
+    static constexpr const char* LATENCY_HISTOGRAM_PATH = "doodle_input_latency.csv";
+    static constexpr const char* LATENCY_SAMPLES_PATH = "doodle_input_events.csv";
     GameConfig config;
-    std::unique_ptr<Player> player;
-    std::vector<std::unique_ptr<Platform>> platforms;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::vector<std::unique_ptr<Projectile>> projectiles;
-    std::vector<std::unique_ptr<Jetpack>> jetpacks;
+    std::unique_ptr<World> world; // only the simulation thread touches it while running
     int screenWidth, screenHeight;
-    int mouseX;
-    int mouseY;
-    float playerCenterX = 0.0f;
-    float playerCenterY = 0.0f;
-    float dirX = 0.0f;
-    float dirY = 0.0f;
-    float velocityX = 0.0f;
-    float velocityY = 0.0f;
     std::chrono::steady_clock::time_point gameOverTime;
-    std::chrono::steady_clock::time_point lastShotTime;
-    int score;
-    float shift;
-    bool gameOver;
-    float deltaTime;
-    std::chrono::steady_clock::time_point lastFrameTime;
+    bool gameOverShown;
+    float stepSeconds;
     ResourceManager& resources;
-    int highestPlatformY;
-    int lastJumpedPlatformId;
-    int platformIdCounter;
-    Gdiplus::GdiplusStartupInput gdiplusStartupInput;
-    ULONG_PTR gdiplusToken;
+    AssetLoader assets;
+    bool assetsReady;   // every manifest entry has reached the cache
+    std::chrono::steady_clock::time_point initStart;
+    bool firstFrameShown;
+    SpriteHandle backdropSprite;
+    SpriteHandle scoreBarSprite;
+    // Indexed by animation::PlayerPose and animation::PlatformVariant.
+    SpriteHandle playerSprites[static_cast<size_t>(animation::PlayerPose::COUNT)];
+    SpriteHandle platformSprites[static_cast<size_t>(animation::PlatformVariant::COUNT)];
+    SpriteHandle enemySprites[3];
+    SpriteHandle projectileSprite;
+    SpriteHandle noseSprite;
+    SpriteHandle digits[10];
+    float renderedCameraY;  // camera of the last rendered frame
+    uint32_t shownTick;     // snapshot tick of the last rendered frame
+    uint32_t frameIndex;
+
+    std::thread simulationThread;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> simulationDone; // the replay ran out or diverged
+    TripleBuffer<RenderSnapshot> snapshots;
+    SpscQueue<TimedInputEvent, 1024> inputQueue;
+    size_t droppedInput;    // window thread: events the full queue turned away
+    InputLatencyTracker inputLatency;
+
+    // Window input is stamped and queued by the entry points below, then
+    // applied at the start of the next step, tagged with the number of steps
+    // run so far.
+    // Replay and agent sessions ignore live input and feed the same path
+    // from the recording or the agent's actions instead. Everything from here
+    // on belongs to the simulation thread while it runs.
+    bool liveInput;
+    InputTranslator translator;
+    uint32_t tick;
+    std::chrono::steady_clock::time_point sessionStart;
+    bool recordingSession;
+    InputRecording recording;
+    bool replaying;
+    bool replayFailed;
+    InputRecording replay;
+    std::unique_ptr<ReplayCursor> replayCursor;
+    std::unique_ptr<Agent> agent;
+    Observation observation;
+    std::vector<InputEvent> agentInput;
 
 public:
     explicit GameManager(const GameConfig& cfg);
@@ -44,27 +85,35 @@ public:
     void PreInit(int& width, int& height, bool& fullscreen) override;
     bool Init() override;
     void Close() override;
-    void showGameOverScreen();
+    void showGameOverScreen(const RenderSnapshot& snapshot);
     bool Tick() override;
     void onMouseMove(int x, int y, int xrelative, int yrelative) override;
     void onMouseButtonClick(FRMouseButton button, bool isReleased) override;
     void onKeyPressed(FRKey k) override;
     void onKeyReleased(FRKey k) override;
     const char* GetTitle() override;
+    void onFramePresented() override;
+    bool hasReplayFailed() const { return replayFailed; }
 
 private:
-    void updateDeltaTime();
-    void updateEntities();
-    void updatePlayer();
-    void updatePlatforms();
-    void updateEnemies();
-    void spawnPlatform();
-    void spawnEnemy();
-    void handleCollisions();
-    void cleanup();
-    void resetGame();
+    void runSimulation();
+    bool simulateTick();
+    void stopSimulation();
+    float interpolationAlpha(const RenderSnapshot& snapshot) const;
+    void restartGame();
+    void queueInput(const InputEvent& event);
+    void dispatchInput(InputEvent event);
+    void injectInput(const InputEvent& event);
+    void deliverReplay();
+    void deliverAgentInput();
+    bool endReplay();
+    void bindSprites();
+    void pollAssets();
+    void render(const RenderSnapshot& snapshot, float alpha);
+    void renderPlayer(const RenderSnapshot& snapshot, float alpha, float cameraY);
+    void drawWorldSprite(const Sprite* sprite, float screenX, float screenY);
     void drawNumber(int number, int x, int y);
-    void updateProjectiles();
-    bool cooldown();
-    void spawnProjectile(float x, float y, float angle);
-};
\ No newline at end of file
+    void renderDebugOverlay();
+    void printPoolStats(const char* name, const PoolStats& stats);
+    void cleanup();
+};
@@ -0,0 +1,174 @@
+#include "GameManager.h"
+#include "Agent.h"
+#include "FixedTimestep.h"
+#include "GameConfig.h"
+#include "InputRecording.h"
+#include "RenderSnapshot.h"
+#include "World.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Fails if a steady-state tick or frame touches the heap. Every allocation in
+// the process goes through the counting operator new below; after a warm-up
+// that lets containers reach their working size, the count must not move.
+//
+// Two phases: a long headless session (agent, World::step and the render
+// snapshot, exactly as the simulation thread runs them, with a restart at
+// least every few thousand ticks), then the real
+// GameManager rendering into a headless framebuffer while its simulation
+// thread runs, which covers drawing, damage tracking and compositing.
+namespace {
+    // A game the agent survives this long is ended, so restarts get checked too.
+    constexpr long long MAX_GAME_TICKS = 3000;
+
+    std::atomic<uint64_t> allocations{ 0 };
+
+    void* countedAlloc(size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* countedAlignedAlloc(size_t size, std::align_val_t align) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        size_t alignment = static_cast<size_t>(align);
+        size = (size + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+        if (void* p = _aligned_malloc(size ? size : alignment, alignment)) return p;
+#else
+        if (void* p = std::aligned_alloc(alignment, size ? size : alignment)) return p;
+#endif
+        throw std::bad_alloc();
+    }
+
+    void alignedFree(void* p) {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    uint64_t allocationCount() { return allocations.load(std::memory_order_relaxed); }
+
+    bool checkSimulation(const GameConfig& config, long long ticks, long long warmup) {
+        float deltaTime = FixedTimestep(config.tickRate).getStep();
+        World world(config, config.windowWidth, config.windowHeight);
+        std::unique_ptr<Agent> agent = createAgent(config.agent, config);
+        if (!agent) { fprintf(stderr, "unknown agent %s\n", config.agent.c_str()); return false; }
+        InputTranslator translator;
+        Observation observation;
+        std::vector<InputEvent> actions;
+        actions.reserve(MAX_ACTION_EVENTS);
+        RenderSnapshot snapshot;
+
+        uint64_t allocated = 0;
+        long long firstBad = -1;
+        int games = 1;
+        long long gameStart = 0;
+        for (long long tick = 0; tick < ticks; ++tick) {
+            uint64_t before = allocationCount();
+            actions.clear();
+            observe(world, static_cast<uint32_t>(tick), observation);
+            appendActionEvents(agent->act(observation), world, actions);
+            for (const InputEvent& event : actions) translator.apply(event, world);
+            world.step(deltaTime);
+            captureSnapshot(world, static_cast<uint32_t>(tick + 1), snapshot);
+            // Restarting after a game over has to be allocation-free as well.
+            if (world.isGameOver() || tick + 1 - gameStart >= MAX_GAME_TICKS) {
+                world.reset();
+                ++games;
+                gameStart = tick + 1;
+            }
+            uint64_t count = allocationCount() - before;
+            if (tick >= warmup && count) {
+                allocated += count;
+                if (firstBad < 0) firstBad = tick;
+            }
+        }
+        printf("simulation: %lld ticks, %d games, %llu allocations after warm-up", ticks, games, static_cast<unsigned long long>(allocated));
+        if (firstBad >= 0) printf(" (first at tick %lld)", firstBad);
+        printf("\n");
+        if (games < 2) printf("simulation: no restart in %lld ticks, run at least %lld\n", ticks, MAX_GAME_TICKS);
+        return allocated == 0 && games > 1;
+    }
+
+    bool checkRendering(const GameConfig& config, double seconds, int warmupFrames) {
+        GameManager game(config);
+        int width, height;
+        bool fullscreen;
+        game.PreInit(width, height, fullscreen);
+        setRenderThreads(config.renderThreads);
+        if (!createFramebuffer(width, height, nullptr) || !game.Init()) { fprintf(stderr, "cannot start the game\n"); return false; }
+
+        uint64_t allocated = 0;
+        long long frames = 0;
+        long long firstBad = -1;
+        uint64_t before = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds) {
+            // Counted from the end of one frame to the end of the next, so the
+            // simulation thread's steps in between are included.
+            beginFrame();
+            bool done = game.Tick();
+            int dirtyCount;
+            endFrame(dirtyCount);
+            game.onFramePresented();
+            uint64_t now = allocationCount();
+            if (frames >= warmupFrames && now != before) {
+                allocated += now - before;
+                if (firstBad < 0) firstBad = frames;
+            }
+            before = now;
+            ++frames;
+            if (done) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        game.Close();
+        destroyFramebuffer();
+        printf("rendering: %lld frames, %llu allocations after warm-up", frames, static_cast<unsigned long long>(allocated));
+        if (firstBad >= 0) printf(" (first at frame %lld)", firstBad);
+        printf("\n");
+        return allocated == 0;
+    }
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+int main(int argc, char* argv[]) {
+    GameConfig config = GameConfig::parseCommandLine(argc, argv);
+    long long ticks = 100000;
+    long long warmupTicks = 600;
+    double renderSeconds = 5.0;
+    int warmupFrames = 120;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) warmupTicks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--render-seconds") == 0 && i + 1 < argc) renderSeconds = atof(argv[++i]);
+    }
+    if (config.agent.empty()) config.agent = "heuristic";
+
+    bool ok = checkSimulation(config, ticks, warmupTicks);
+    if (renderSeconds > 0) ok = checkRendering(config, renderSeconds, warmupFrames) && ok;
+    printf(ok ? "PASS: steady state is allocation-free\n" : "FAIL: steady-state ticks allocate\n");
+    return ok ? 0 : 1;
+}
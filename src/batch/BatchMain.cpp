@@ -0,0 +1,134 @@
+#include "World.h"
+#include "Agent.h"
+#include "FixedTimestep.h"
+#include "GameConfig.h"
+#include "InputRecording.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Plays many independent headless games in parallel for balancing runs. Each
+// game gets its own World seeded with base seed + game index and is driven by
+// its own agent (--agent, heuristic by default) until game over or the tick cap. The tuning flags
+// (--enemy-chance, --disappear-chance, --min-interval, --max-interval) come in
+// through GameConfig like every other option.
+namespace {
+    struct RunResult {
+        uint64_t seed = 0;
+        uint32_t ticks = 0;
+        int score = 0;
+        int platforms = 0;
+        bool gameOver = false;
+    };
+
+    RunResult playGame(GameConfig config, uint64_t seed, uint32_t maxTicks) {
+        config.seed = seed;
+        // The pool already keeps every core busy; a level worker per game
+        // would only oversubscribe it. The level comes out the same either way.
+        config.levelThread = false;
+        float deltaTime = FixedTimestep(config.tickRate).getStep();
+        World world(config, config.windowWidth, config.windowHeight);
+        std::unique_ptr<Agent> agent = createAgent(config.agent, config);
+        InputTranslator translator;
+        Observation observation;
+        std::vector<InputEvent> input;
+        input.reserve(MAX_ACTION_EVENTS);
+
+        RunResult result;
+        result.seed = seed;
+        while (result.ticks < maxTicks && !world.isGameOver()) {
+            input.clear();
+            observe(world, result.ticks, observation);
+            appendActionEvents(agent->act(observation), world, input);
+            for (const InputEvent& event : input) translator.apply(event, world);
+            world.step(deltaTime);
+            ++result.ticks;
+        }
+        result.score = world.getScore();
+        result.platforms = world.getPlayer()->getPlatformsCount();
+        result.gameOver = world.isGameOver();
+        return result;
+    }
+
+    template <typename T>
+    T percentile(std::vector<T> values, double fraction) {
+        if (values.empty()) return T();
+        size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    GameConfig config = GameConfig::parseCommandLine(argc, argv);
+    long long games = 1000;
+    long long maxTicks = 36000;
+    size_t threads = 0;
+    const char* csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc) maxTicks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = static_cast<size_t>(atoll(argv[++i]));
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csvPath = argv[++i];
+    }
+    if (games < 1) games = 1;
+    if (config.agent.empty()) config.agent = "heuristic";
+    if (!createAgent(config.agent, config)) { fprintf(stderr, "unknown agent %s\n", config.agent.c_str()); return 1; }
+
+    std::vector<RunResult> results(static_cast<size_t>(games));
+    ThreadPool pool(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < results.size(); ++i) {
+        pool.submit([&, i] { results[i] = playGame(config, config.seed + i, static_cast<uint32_t>(maxTicks)); });
+    }
+    pool.wait();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned long long totalTicks = 0;
+    size_t finished = 0;
+    std::vector<int> scores, platforms;
+    scores.reserve(results.size());
+    platforms.reserve(results.size());
+    for (const RunResult& r : results) {
+        totalTicks += r.ticks;
+        finished += r.gameOver ? 1 : 0;
+        scores.push_back(r.score);
+        platforms.push_back(r.platforms);
+        if (config.debugMode) printf("seed %llu: %s after %u ticks, score %d, platforms %d\n", static_cast<unsigned long long>(r.seed),
+            r.gameOver ? "game over" : "tick cap", r.ticks, r.score, r.platforms);
+    }
+
+    double ticksPerSecond = seconds > 0 ? totalTicks / seconds : 0.0;
+    size_t cores = std::min<size_t>(pool.getThreadCount(), std::max(1u, std::thread::hardware_concurrency()));
+    printf("games: %lld on %zu threads (%zu tasks stolen), seeds %llu..%llu\n", games, pool.getThreadCount(), pool.getStealCount(),
+        static_cast<unsigned long long>(config.seed), static_cast<unsigned long long>(config.seed + games - 1));
+    printf("agent: %s\n", config.agent.c_str());
+    printf("tuning: enemy chance %d%%, disappear chance %d%%, platform interval %d..%d\n",
+        config.enemySpawnChance, config.platformDisappearingChance, config.minPlatformInterval, config.maxPlatformInterval);
+    printf("ticks: %llu in %.3f s, %.0f ticks/s, %.0f ticks/s/core\n", totalTicks, seconds, ticksPerSecond, ticksPerSecond / cores);
+    printf("game over: %zu, hit tick cap: %zu\n", finished, results.size() - finished);
+    long long scoreSum = 0, platformSum = 0;
+    for (size_t i = 0; i < results.size(); ++i) { scoreSum += scores[i]; platformSum += platforms[i]; }
+    printf("score: mean %.1f, p50 %d, p90 %d, max %d\n", static_cast<double>(scoreSum) / games,
+        percentile(scores, 0.5), percentile(scores, 0.9), *std::max_element(scores.begin(), scores.end()));
+    printf("platforms: mean %.1f, p50 %d, p90 %d, max %d\n", static_cast<double>(platformSum) / games,
+        percentile(platforms, 0.5), percentile(platforms, 0.9), *std::max_element(platforms.begin(), platforms.end()));
+
+    if (csvPath) {
+        FILE* csv = fopen(csvPath, "w");
+        if (!csv) { fprintf(stderr, "cannot write %s\n", csvPath); return 1; }
+        fprintf(csv, "seed,ticks,score,platforms,game_over\n");
+        for (const RunResult& r : results)
+            fprintf(csv, "%llu,%u,%d,%d,%d\n", static_cast<unsigned long long>(r.seed), r.ticks, r.score, r.platforms, r.gameOver ? 1 : 0);
+        fclose(csv);
+        printf("per-run results written to %s\n", csvPath);
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "Agent.h"
+#include "FixedTimestep.h"
+#include "GameConfig.h"
+#include "HeuristicBot.h"
+#include "Profiler.h"
+#include "ScriptedAgent.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Keeps the capacity entries closest to referenceY, sorted by distance.
+    void collectNearest(const EntityStore& store, float referenceY, ObservedEntity* out, size_t capacity, size_t& count) {
+        float distances[Observation::MAX_PLATFORMS > Observation::MAX_ENEMIES ? Observation::MAX_PLATFORMS : Observation::MAX_ENEMIES];
+        count = 0;
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (!store.isActive(i)) continue;
+            float distance = std::fabs(store.y[i] - referenceY);
+            if (count == capacity && distance >= distances[count - 1]) continue;
+
+            size_t slot = count < capacity ? count++ : capacity - 1;
+            while (slot > 0 && distances[slot - 1] > distance) {
+                distances[slot] = distances[slot - 1];
+                out[slot] = out[slot - 1];
+                --slot;
+            }
+            distances[slot] = distance;
+            out[slot] = { store.x[i], store.y[i], store.width[i], store.height[i], store.velocityX[i], store.velocityY[i],
+                store.value[i], store.hasFlag(i, ENTITY_DISAPPEARING), store.variant[i] };
+        }
+    }
+
+    InputEvent keyEvent(InputEventType type, InputKey key) {
+        InputEvent event;
+        event.type = type;
+        event.code = static_cast<uint8_t>(key);
+        return event;
+    }
+}
+
+void observe(const World& world, uint32_t tick, Observation& observation) {
+    DJ_PROFILE_ZONE("observe");
+    const Player* player = world.getPlayer();
+    observation.tick = tick;
+    observation.worldWidth = world.getWidth();
+    observation.worldHeight = world.getHeight();
+    observation.cameraY = world.getCameraY();
+    observation.playerX = player ? player->getX() : 0.0f;
+    observation.playerY = player ? player->getY() : 0.0f;
+    observation.velocityX = player ? player->getVelocityX() : 0.0f;
+    observation.velocityY = player ? player->getVelocityY() : 0.0f;
+    observation.canShoot = !world.cooldown();
+    observation.score = world.getScore();
+    observation.platformsCount = player ? player->getPlatformsCount() : 0;
+    collectNearest(world.getPlatforms(), observation.playerY, observation.platforms, Observation::MAX_PLATFORMS, observation.platformCount);
+    collectNearest(world.getEnemies(), observation.playerY, observation.enemies, Observation::MAX_ENEMIES, observation.enemyCount);
+}
+
+void appendActionEvents(const AgentAction& action, const World& world, std::vector<InputEvent>& out) {
+    switch (action.move) {
+    case MoveAction::None: break;
+    case MoveAction::Left: out.push_back(keyEvent(InputEventType::KeyPressed, InputKey::Left)); break;
+    case MoveAction::Right: out.push_back(keyEvent(InputEventType::KeyPressed, InputKey::Right)); break;
+    case MoveAction::Stop:
+        out.push_back(keyEvent(InputEventType::KeyReleased, InputKey::Left));
+        out.push_back(keyEvent(InputEventType::KeyReleased, InputKey::Right));
+        break;
+    }
+
+    if (action.shoot) {
+        InputEvent move;
+        move.type = InputEventType::MouseMove;
+        move.x = static_cast<int32_t>(action.targetX);
+        move.y = static_cast<int32_t>(action.targetY - world.getCameraY());
+        out.push_back(move);
+        InputEvent click;
+        click.type = InputEventType::MouseButton;
+        click.code = static_cast<uint8_t>(InputMouseButton::Left);
+        out.push_back(click);
+    }
+}
+
+std::unique_ptr<Agent> createAgent(const std::string& name, const GameConfig& config) {
+    if (name == "heuristic") {
+        int tickRate = FixedTimestep(config.tickRate).getTickRate();
+        HeuristicBotSkill skill;
+        skill.reactionTicks = std::max(config.agentReactionMs, 0) * tickRate / 1000;
+        skill.aimError = std::max(config.agentAimError, 0.0f);
+        skill.lapseChance = config.agentLapseChance;
+        skill.lapseTicks = std::max(config.agentLapseMs, 0) * tickRate / 1000;
+        return std::make_unique<HeuristicBot>(config.seed, skill);
+    }
+    if (name == "scripted") return std::make_unique<ScriptedAgent>();
+    return nullptr;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "InputRecording.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class World;
+struct GameConfig;
+
+// What an agent sees each tick: the player plus the platforms and enemies
+// nearest to it vertically, in world coordinates. Fixed-size so observing
+// never allocates.
+struct ObservedEntity {
+    float x, y, width, height;
+    float velocityX, velocityY;
+    float opacity;      // platforms: fades from 1 to 0 once disappearing
+    bool disappearing;
+    uint8_t variant;    // enemies: type
+};
+
+struct Observation {
+    static constexpr size_t MAX_PLATFORMS = 16;
+    static constexpr size_t MAX_ENEMIES = 8;
+
+    uint32_t tick;
+    int worldWidth, worldHeight;
+    float cameraY;
+    float playerX, playerY;
+    float velocityX, velocityY;
+    bool canShoot;
+    int score;
+    int platformsCount;
+    // Sorted nearest first by vertical distance to the player.
+    ObservedEntity platforms[MAX_PLATFORMS];
+    size_t platformCount;
+    ObservedEntity enemies[MAX_ENEMIES];
+    size_t enemyCount;
+};
+
+enum class MoveAction : uint8_t {
+    None,   // keep the current horizontal velocity
+    Left,
+    Right,
+    Stop
+};
+
+struct AgentAction {
+    MoveAction move = MoveAction::None;
+    bool shoot = false;
+    float targetX = 0.0f;   // world space
+    float targetY = 0.0f;
+};
+
+class Agent {
+public:
+    virtual ~Agent() = default;
+    virtual const char* getName() const = 0;
+    virtual AgentAction act(const Observation& observation) = 0;
+};
+
+void observe(const World& world, uint32_t tick, Observation& observation);
+
+// Expresses an action as the key and mouse events a player would produce, so
+// agent sessions go through the same input path and can be recorded. Appends
+// at most MAX_ACTION_EVENTS; reserve that much to keep ticks allocation-free.
+constexpr size_t MAX_ACTION_EVENTS = 4;
+void appendActionEvents(const AgentAction& action, const World& world, std::vector<InputEvent>& out);
+
+// "heuristic" or "scripted"; null for anything else. Agents that draw random
+// numbers seed them from the config.
+std::unique_ptr<Agent> createAgent(const std::string& name, const GameConfig& config);
@@ -0,0 +1,97 @@
+#pragma once
+#include "RenderSnapshot.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Sprite selection as table lookups. Each animated thing packs the conditions
+// that pick its frame into a small state index; a constexpr rule maps every
+// index to a frame, and the table holding the results is built at compile
+// time. Drawing code only ever does table[state], so adding a pose means a new
+// enum value, a row in the pose list and a line in the rule.
+namespace animation {
+    template <size_t Count, typename Rule>
+    constexpr auto makeStateTable(Rule rule) {
+        std::array<decltype(rule(size_t())), Count> table = {};
+        for (size_t state = 0; state < Count; ++state) table[state] = rule(state);
+        return table;
+    }
+
+    enum class PlayerPose : uint8_t { LeftUp, LeftDown, RightUp, RightDown, UpUp, UpDown, COUNT };
+
+    struct PoseInfo {
+        const char* sprite;
+        bool nose;          // the nose sprite is drawn on top, aimed at the cursor
+        float noseOffsetY;
+    };
+
+    constexpr PoseInfo PLAYER_POSES[] = {
+        { "material/leftup.png", false, 0.0f },
+        { "material/leftdown.png", false, 0.0f },
+        { "material/rightup.png", false, 0.0f },
+        { "material/rightdown.png", false, 0.0f },
+        { "material/upup.png", true, 0.0f },
+        { "material/updown.png", true, 6.0f },
+    };
+    static_assert(std::size(PLAYER_POSES) == static_cast<size_t>(PlayerPose::COUNT), "one PoseInfo per pose");
+
+    enum PlayerStateBit : uint8_t {
+        FACING_RIGHT = 1 << 0,
+        FALLING = 1 << 1,
+        LOOKING_UP = 1 << 2,
+        PLAYER_STATE_COUNT = 1 << 3
+    };
+
+    constexpr PlayerPose selectPlayerPose(size_t state) {
+        bool falling = (state & FALLING) != 0;
+        if (state & LOOKING_UP) return falling ? PlayerPose::UpDown : PlayerPose::UpUp;
+        if (state & FACING_RIGHT) return falling ? PlayerPose::RightDown : PlayerPose::RightUp;
+        return falling ? PlayerPose::LeftDown : PlayerPose::LeftUp;
+    }
+
+    constexpr auto PLAYER_POSE_TABLE = makeStateTable<PLAYER_STATE_COUNT>(selectPlayerPose);
+
+    inline size_t playerState(const RenderSnapshot& snapshot) {
+        return static_cast<size_t>(snapshot.lookingRight) * FACING_RIGHT
+            | static_cast<size_t>(snapshot.falling) * FALLING
+            | static_cast<size_t>(snapshot.lookingUp) * LOOKING_UP;
+    }
+
+    inline PlayerPose playerPose(const RenderSnapshot& snapshot) { return PLAYER_POSE_TABLE[playerState(snapshot)]; }
+
+    // Platforms fade through three sprites as their opacity drops.
+    enum class PlatformVariant : uint8_t { Solid, Fading, Faint, COUNT };
+
+    constexpr const char* PLATFORM_SPRITES[] = { "material/100.png", "material/75.png", "material/25.png" };
+    static_assert(std::size(PLATFORM_SPRITES) == static_cast<size_t>(PlatformVariant::COUNT), "one sprite per variant");
+
+    constexpr float SOLID_ABOVE = 0.75f;
+    constexpr float FADING_ABOVE = 0.25f;
+
+    // Opacity is quantised into steps of 1/OPACITY_STEPS, step k covering
+    // (k / OPACITY_STEPS, (k + 1) / OPACITY_STEPS]. With the thresholds on step
+    // boundaries the table gives exactly what comparing against them would.
+    constexpr int OPACITY_STEPS = 64;
+    static_assert(SOLID_ABOVE * OPACITY_STEPS == static_cast<int>(SOLID_ABOVE * OPACITY_STEPS), "threshold off the step grid");
+    static_assert(FADING_ABOVE * OPACITY_STEPS == static_cast<int>(FADING_ABOVE * OPACITY_STEPS), "threshold off the step grid");
+
+    constexpr PlatformVariant selectPlatformVariant(size_t step) {
+        float lower = static_cast<float>(step) / OPACITY_STEPS;
+        return lower >= SOLID_ABOVE ? PlatformVariant::Solid : lower >= FADING_ABOVE ? PlatformVariant::Fading : PlatformVariant::Faint;
+    }
+
+    constexpr auto PLATFORM_VARIANT_TABLE = makeStateTable<OPACITY_STEPS>(selectPlatformVariant);
+
+    // Scaling by a power of two is exact, so an opacity sitting on a step
+    // boundary belongs to the step below.
+    inline size_t opacityStep(float opacity) {
+        float scaled = opacity * OPACITY_STEPS;
+        int step = static_cast<int>(scaled);
+        step -= static_cast<float>(step) == scaled;
+        return static_cast<size_t>(std::clamp(step, 0, OPACITY_STEPS - 1));
+    }
+
+    inline PlatformVariant platformVariant(float opacity) { return PLATFORM_VARIANT_TABLE[opacityStep(opacity)]; }
+}
@@ -0,0 +1,41 @@
+#include "Entity.h"
+#include <algorithm>
+
+Player::Player(float x, float y, float playerSpeed)
+    : Entity(x, y)
+    , gravity(GameConstants::GRAVITY)
+    , speed(playerSpeed)
+{
+    velocityY = 50;
+}
+
+void Player::update(float deltaTime) {
+    if (!hasJetpack) {
+        velocityY += gravity * deltaTime;
+        velocityY = std::min(velocityY, GameConstants::MAX_FALL_SPEED);
+    } else {
+        velocityY = -GameConstants::JETPACK_SPEED;
+        jetpackTime -= deltaTime;
+        if (jetpackTime <= 0.0f) hasJetpack = false;
+    }
+
+    y += velocityY * deltaTime;
+    x += velocityX * deltaTime;
+}
+
+void Player::moveLeft() {
+    velocityX = -speed * GameConstants::BASE_PLAYER_SPEED;
+    isLookingRight = false;
+}
+
+void Player::moveRight() {
+    velocityX = speed * GameConstants::BASE_PLAYER_SPEED;
+    isLookingRight = true;
+}
+
+void Player::stop() { velocityX = 0; }
+
+void Player::startJetpack() {
+    hasJetpack = true;
+    jetpackTime = GameConstants::JETPACK_DURATION / 1000.0f;
+}
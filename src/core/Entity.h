@@ -0,0 +1,71 @@
+#pragma once
+#include "GameConfig.h"
+#include "EntityStore.h"
+
+// Simulation-side entity state. Platforms, enemies and projectiles live in
+// per-kind EntityStores owned by the World; the player is a single object.
+// None of it knows how it looks on screen.
+class Entity {
+protected:
+    float x, y;
+    float prevX, prevY;
+    float velocityX = 0;
+    float velocityY = 0;
+    bool active = true;
+
+public:
+    Entity(float startX, float startY) : x(startX), y(startY), prevX(startX), prevY(startY) {}
+
+    bool isActive() const { return active; }
+    void setActive(bool value) { active = value; }
+
+    float getX() const { return x; }
+    float getY() const { return y; }
+    float getVelocityX() const { return velocityX; }
+    float getVelocityY() const { return velocityY; }
+    void setVelocityX(float newVelocity) { velocityX = newVelocity; }
+    void setVelocityY(float newVelocity) { velocityY = newVelocity; }
+
+    void setPosition(float newX, float newY) { x = newX; y = newY; }
+
+    void savePreviousPosition() { prevX = x; prevY = y; }
+    float getPreviousX() const { return prevX; }
+    float getPreviousY() const { return prevY; }
+    float getInterpolatedX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float getInterpolatedY(float alpha) const { return prevY + (y - prevY) * alpha; }
+};
+
+class Player : public Entity {
+private:
+    float gravity;
+    float speed;
+    bool isLookingRight = true;
+    bool isCrouching = false;
+    bool hasJetpack = false;
+    float jetpackTime = 0.0f; // seconds of thrust left
+    bool isLookingUp = false;
+    float noseAngle = 0;
+    EntityHandle lastJumpedPlatform;
+    int platformsCount = 0;
+
+public:
+    Player(float x, float y, float playerSpeed);
+    void update(float deltaTime);
+    void moveLeft();
+    void moveRight();
+    void stop();
+    void jump() { velocityY = GameConstants::JUMP_FORCE; }
+    void startJetpack();
+    bool isUsingJetpack() const { return hasJetpack; }
+    float getJetpackTime() const { return jetpackTime; }
+    bool isLookingToRight() const { return isLookingRight; }
+    bool isFalling() const { return velocityY > 50.0f; }
+    int getPlatformsCount() const { return platformsCount; }
+    EntityHandle getLastJumpedPlatform() const { return lastJumpedPlatform; }
+    void setLastJumpedPlatform(EntityHandle platform) { lastJumpedPlatform = platform; }
+    void updatePlatformCount() { ++platformsCount; }
+    bool getLookingUp() const { return isLookingUp; }
+    void setLookingUp(bool value) { isLookingUp = value; }
+    float getNoseAngle() const { return noseAngle; }
+    void setNoseAngle(float angle) { noseAngle = angle; }
+};
@@ -0,0 +1,103 @@
+#include "EntityStore.h"
+
+void EntityStore::setCapacity(size_t capacity) {
+    x.clear(); y.clear();
+    prevX.clear(); prevY.clear();
+    velocityX.clear(); velocityY.clear();
+    width.clear(); height.clear();
+    value.clear(); variant.clear(); flags.clear();
+    handles.clear();
+
+    x.reserve(capacity); y.reserve(capacity);
+    prevX.reserve(capacity); prevY.reserve(capacity);
+    velocityX.reserve(capacity); velocityY.reserve(capacity);
+    width.reserve(capacity); height.reserve(capacity);
+    value.reserve(capacity); variant.reserve(capacity); flags.reserve(capacity);
+    handles.reserve(capacity);
+
+    slotToIndex.assign(capacity, 0);
+    slotGeneration.assign(capacity, 0);
+    freeSlots.clear();
+    freeSlots.reserve(capacity);
+    // Hand out low slots first.
+    for (size_t slot = capacity; slot > 0; --slot) freeSlots.push_back(static_cast<uint32_t>(slot - 1));
+
+    stats = PoolStats();
+    stats.capacity = capacity;
+}
+
+EntityHandle EntityStore::create(float startX, float startY, float entityWidth, float entityHeight) {
+    if (freeSlots.empty()) { ++stats.exhausted; return EntityHandle(); }
+
+    uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    EntityHandle handle{ slot, slotGeneration[slot] };
+    slotToIndex[slot] = static_cast<uint32_t>(handles.size());
+    handles.push_back(handle);
+
+    x.push_back(startX);
+    y.push_back(startY);
+    prevX.push_back(startX);
+    prevY.push_back(startY);
+    velocityX.push_back(0.0f);
+    velocityY.push_back(0.0f);
+    width.push_back(entityWidth);
+    height.push_back(entityHeight);
+    value.push_back(0.0f);
+    variant.push_back(0);
+    flags.push_back(ENTITY_ACTIVE);
+
+    stats.live = handles.size();
+    if (stats.live > stats.highWater) stats.highWater = stats.live;
+    return handle;
+}
+
+bool EntityStore::contains(EntityHandle handle) const {
+    return handle.isValid() && handle.slot < slotGeneration.size() && slotGeneration[handle.slot] == handle.generation
+        && slotToIndex[handle.slot] < handles.size() && handles[slotToIndex[handle.slot]] == handle;
+}
+
+void EntityStore::clear() {
+    for (size_t i = 0; i < handles.size(); ++i) release(i);
+    truncate(0);
+    stats.live = 0;
+}
+
+void EntityStore::savePreviousPositions() {
+    size_t count = size();
+    for (size_t i = 0; i < count; ++i) { prevX[i] = x[i]; prevY[i] = y[i]; }
+}
+
+void EntityStore::integrate(float deltaTime) {
+    size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        x[i] += velocityX[i] * deltaTime;
+        y[i] += velocityY[i] * deltaTime;
+    }
+}
+
+void EntityStore::move(size_t from, size_t to) {
+    x[to] = x[from]; y[to] = y[from];
+    prevX[to] = prevX[from]; prevY[to] = prevY[from];
+    velocityX[to] = velocityX[from]; velocityY[to] = velocityY[from];
+    width[to] = width[from]; height[to] = height[from];
+    value[to] = value[from]; variant[to] = variant[from]; flags[to] = flags[from];
+    handles[to] = handles[from];
+    slotToIndex[handles[to].slot] = static_cast<uint32_t>(to);
+}
+
+void EntityStore::release(size_t index) {
+    uint32_t slot = handles[index].slot;
+    ++slotGeneration[slot];
+    freeSlots.push_back(slot);
+}
+
+void EntityStore::truncate(size_t count) {
+    x.resize(count); y.resize(count);
+    prevX.resize(count); prevY.resize(count);
+    velocityX.resize(count); velocityY.resize(count);
+    width.resize(count); height.resize(count);
+    value.resize(count); variant.resize(count); flags.resize(count);
+    handles.resize(count);
+}
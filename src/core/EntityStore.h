@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Stable reference to an entity in an EntityStore. The generation tells a
+// live entity apart from whatever later reuses its slot.
+struct EntityHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return slot != UINT32_MAX; }
+    bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+enum EntityFlags : uint8_t {
+    ENTITY_ACTIVE = 1 << 0,
+    ENTITY_DISAPPEARING = 1 << 1,
+    ENTITY_CHECKED_FOR_DISAPPEARING = 1 << 2,
+    ENTITY_HAS_ENEMY = 1 << 3,
+    ENTITY_HAS_JETPACK = 1 << 4
+};
+
+struct PoolStats {
+    size_t capacity = 0;
+    size_t live = 0;
+    size_t highWater = 0;
+    size_t exhausted = 0; // create() calls refused because the pool was full
+};
+
+// Packed structure-of-arrays storage for one entity kind. Live entities sit
+// contiguously at indices [0, size()) in every array so update, cull and
+// collision loops scan linear memory; handles map to the current index through
+// a slot table so they survive removals that compact the arrays.
+//
+// The store is a fixed-capacity pool: every array and the slot free list are
+// allocated up front, destroyed entities return their slot to the free list
+// and the next spawn reuses it in place. create() never touches the heap and
+// returns an invalid handle once the pool is exhausted.
+class EntityStore {
+public:
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> width, height;
+    std::vector<float> value;     // per-kind scalar: platform opacity, projectile angle
+    std::vector<uint8_t> variant; // per-kind discriminator: enemy type
+    std::vector<uint8_t> flags;
+
+    explicit EntityStore(size_t capacity = 0) { setCapacity(capacity); }
+
+    // Drops every live entity and reallocates the pool.
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return stats.capacity; }
+    const PoolStats& getStats() const { return stats; }
+
+    EntityHandle create(float startX, float startY, float entityWidth, float entityHeight);
+    bool contains(EntityHandle handle) const;
+    size_t indexOf(EntityHandle handle) const { return slotToIndex[handle.slot]; }
+    EntityHandle handleAt(size_t index) const { return handles[index]; }
+    size_t size() const { return handles.size(); }
+    bool empty() const { return handles.empty(); }
+    void clear();
+
+    bool isActive(size_t index) const { return (flags[index] & ENTITY_ACTIVE) != 0; }
+    bool hasFlag(size_t index, uint8_t flag) const { return (flags[index] & flag) != 0; }
+    void setFlag(size_t index, uint8_t flag, bool enabled = true) { if (enabled) flags[index] |= flag; else flags[index] &= ~flag; }
+
+    float interpolatedX(size_t index, float alpha) const { return prevX[index] + (x[index] - prevX[index]) * alpha; }
+    float interpolatedY(size_t index, float alpha) const { return prevY[index] + (y[index] - prevY[index]) * alpha; }
+
+    void savePreviousPositions();
+    void integrate(float deltaTime);
+
+    // Drops every entity for which pred(index) is true, keeping the order of
+    // the survivors.
+    template <typename Pred>
+    void removeIf(Pred pred) {
+        size_t count = size();
+        size_t write = 0;
+        for (size_t read = 0; read < count; ++read) {
+            if (pred(read)) { release(read); continue; }
+            if (write != read) move(read, write);
+            ++write;
+        }
+        truncate(write);
+        stats.live = write;
+    }
+
+    void removeInactive() { removeIf([this](size_t i) { return !isActive(i); }); }
+
+private:
+    std::vector<EntityHandle> handles;
+    std::vector<uint32_t> slotToIndex;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+    PoolStats stats;
+
+    void move(size_t from, size_t to);
+    void release(size_t index);
+    void truncate(size_t count);
+};
+
+inline bool overlaps(float x1, float y1, float width1, float height1, float x2, float y2, float width2, float height2) {
+    return x1 < x2 + width2 && x1 + width1 > x2 && y1 < y2 + height2 && y1 + height1 > y2;
+}
@@ -0,0 +1,7 @@
+#include "FixedTimestep.h"
+#include "GameConfig.h"
+
+FixedTimestep::FixedTimestep(int rate)
+    : tickRate(rate > 0 ? rate : GameConstants::DEFAULT_TICK_RATE)
+    , stepSeconds(1.0 / tickRate)
+{}
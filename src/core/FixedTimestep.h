@@ -0,0 +1,16 @@
+#pragma once
+
+// The simulation's fixed step. A tick rate that isn't positive falls back to
+// the default, so everything that derives timing from a config (the sim loop,
+// its pacing, the level generator) agrees on the same step.
+class FixedTimestep {
+private:
+    int tickRate;
+    double stepSeconds;
+
+public:
+    explicit FixedTimestep(int rate);
+
+    int getTickRate() const { return tickRate; }
+    float getStep() const { return static_cast<float>(stepSeconds); }
+};
@@ -0,0 +1,44 @@
+#include "FrameArena.h"
+#include <cstring>
+#include <new>
+
+FrameArena::FrameArena(size_t size, bool poisonReleased)
+    : buffer(new uint8_t[size])
+    , capacity(size)
+    , poison(poisonReleased)
+{
+    if (poison) memset(buffer.get(), POISON_BYTE, capacity);
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer.get());
+    uintptr_t start = (base + used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    size_t end = static_cast<size_t>(start - base) + bytes;
+    if (end > capacity) {
+        ++overflows;
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    used = end;
+    if (used > highWater) highWater = used;
+    return reinterpret_cast<void*>(start);
+}
+
+void FrameArena::deallocate(void* p, size_t bytes, size_t alignment) {
+    if (!p || owns(p)) return;
+    ::operator delete(p, bytes == 0 ? 1 : bytes, std::align_val_t(alignment));
+}
+
+void FrameArena::reset() {
+    if (poison) memset(buffer.get(), POISON_BYTE, used);
+    used = 0;
+}
+
+FrameArenaStats FrameArena::getStats() const {
+    FrameArenaStats stats;
+    stats.capacity = capacity;
+    stats.used = used;
+    stats.highWater = highWater;
+    stats.overflows = overflows;
+    return stats;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct FrameArenaStats {
+    size_t capacity = 0;
+    size_t used = 0;        // since the last reset
+    size_t highWater = 0;   // most used in any one frame
+    size_t overflows = 0;   // allocations that didn't fit and went to the heap
+};
+
+// Bump allocator for data that lives for one frame. Allocating moves a
+// pointer; reset() at the start of the next frame drops everything at once,
+// so long sessions can't fragment it. Requests that don't fit fall back to
+// the heap and are counted, never failed. Not thread-safe: each arena
+// belongs to the thread that resets it.
+class FrameArena {
+public:
+#ifdef _DEBUG
+    static constexpr bool POISON_BY_DEFAULT = true;
+#else
+    static constexpr bool POISON_BY_DEFAULT = false;
+#endif
+    // Written over released memory when poisoning, so stale reads show up.
+    static constexpr uint8_t POISON_BYTE = 0xCD;
+
+    explicit FrameArena(size_t capacity, bool poison = POISON_BY_DEFAULT);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+    // Only heap fallbacks are really freed; arena memory waits for reset().
+    void deallocate(void* p, size_t bytes, size_t alignment);
+    void reset();
+
+    bool owns(const void* p) const {
+        auto address = reinterpret_cast<uintptr_t>(p);
+        auto base = reinterpret_cast<uintptr_t>(buffer.get());
+        return address >= base && address < base + capacity;
+    }
+    void setPoisoning(bool on) { poison = on; }
+    FrameArenaStats getStats() const;
+
+private:
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t capacity;
+    size_t used = 0;
+    size_t highWater = 0;
+    size_t overflows = 0;
+    bool poison;
+};
+
+// Standard allocator over a FrameArena, for containers that live no longer
+// than the frame. Containers built with it must be gone (or rebuilt) before
+// the arena is reset.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& frameArena) noexcept : arena(&frameArena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T* p, size_t count) noexcept { arena->deallocate(p, count * sizeof(T), alignof(T)); }
+    FrameArena* getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,126 @@
+#include "FramePacer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace {
+    int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const int64_t SPIN_NS = static_cast<int64_t>(FramePacer::SPIN_SECONDS * 1e9);
+}
+
+FramePacer::FramePacer(int fps)
+    : targetFps(0)
+    , periodNs(0)
+    , deadlineNs(0)
+    , lastFrameNs(0)
+    , intervals(HISTORY)
+    , intervalCount(0)
+    , timer(nullptr)
+    , raisedTimerResolution(false)
+{
+#ifdef _WIN32
+    // High-resolution timers (Windows 10 1803+) wake within ~0.5 ms. Older
+    // systems get a regular timer with the scheduler tick raised to 1 ms.
+    timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer) {
+        raisedTimerResolution = timeBeginPeriod(1) == TIMERR_NOERROR;
+        timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+    setTargetFps(fps);
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    if (timer) CloseHandle(timer);
+    if (raisedTimerResolution) timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::setTargetFps(int fps) {
+    targetFps = fps > 0 ? fps : 0;
+    periodNs = targetFps ? 1000000000LL / targetFps : 0;
+    deadlineNs = 0;
+    resetStats();
+}
+
+void FramePacer::wait() {
+    if (periodNs) {
+        DJ_PROFILE_ZONE("FramePacer::wait");
+        int64_t current = now();
+        if (!deadlineNs) deadlineNs = current;
+        deadlineNs += periodNs;
+        // A frame that ran over by more than a period starts a new schedule
+        // rather than rushing the next ones to catch up.
+        if (deadlineNs < current - periodNs) deadlineNs = current;
+        else sleepUntil(deadlineNs);
+    }
+
+    int64_t frameEnd = now();
+    if (lastFrameNs) intervals[intervalCount++ % HISTORY] = frameEnd - lastFrameNs;
+    lastFrameNs = frameEnd;
+}
+
+void FramePacer::sleepUntil(int64_t targetNs) {
+    int64_t remaining = targetNs - now() - SPIN_NS;
+    if (remaining > 0) {
+#ifdef _WIN32
+        if (timer) {
+            LARGE_INTEGER due;
+            due.QuadPart = -(remaining / 100); // relative, in 100 ns units
+            if (SetWaitableTimerEx(static_cast<HANDLE>(timer), &due, 0, nullptr, nullptr, nullptr, 0))
+                WaitForSingleObject(static_cast<HANDLE>(timer), INFINITE);
+        }
+        else Sleep(static_cast<DWORD>(remaining / 1000000));
+#else
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining));
+#endif
+    }
+    while (now() < targetNs) std::this_thread::yield();
+}
+
+FramePacingStats FramePacer::getStats() const {
+    FramePacingStats stats;
+    size_t count = std::min(intervalCount, HISTORY);
+    stats.targetMs = periodNs / 1e6;
+    if (count == 0) return stats;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) sum += intervals[i];
+    double mean = sum / count;
+    double reference = periodNs ? static_cast<double>(periodNs) : mean;
+
+    double variance = 0.0;
+    std::vector<double> errors(count);
+    for (size_t i = 0; i < count; ++i) {
+        double d = intervals[i] - mean;
+        variance += d * d;
+        errors[i] = std::fabs(intervals[i] - reference);
+    }
+    std::sort(errors.begin(), errors.end());
+
+    stats.frames = count;
+    stats.meanMs = mean / 1e6;
+    stats.jitterMs = std::sqrt(variance / count) / 1e6;
+    stats.p99ErrorMs = errors[static_cast<size_t>(0.99 * (count - 1) + 0.5)] / 1e6;
+    stats.maxErrorMs = errors.back() / 1e6;
+    return stats;
+}
+
+void FramePacer::resetStats() {
+    intervalCount = 0;
+    lastFrameNs = 0;
+}
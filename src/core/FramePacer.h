@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FramePacingStats {
+    size_t frames = 0;
+    double targetMs = 0.0;      // 0 when uncapped
+    double meanMs = 0.0;        // average frame interval
+    double jitterMs = 0.0;      // standard deviation of the interval
+    double p99ErrorMs = 0.0;    // |interval - target|; against the mean when uncapped
+    double maxErrorMs = 0.0;
+};
+
+// Holds the main loop to a target frame rate without burning a core. Each
+// wait sleeps on a high-resolution timer until just before the deadline and
+// spins only for the final fraction of a millisecond. A target of 0 runs
+// uncapped, which still records frame intervals for the stats.
+class FramePacer {
+public:
+    // Sleeps are not trusted closer to the deadline than this.
+    static constexpr double SPIN_SECONDS = 0.0005;
+
+    explicit FramePacer(int targetFps = 0);
+    ~FramePacer();
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    void setTargetFps(int fps);
+    int getTargetFps() const { return targetFps; }
+
+    // Call once per frame, after presenting.
+    void wait();
+
+    FramePacingStats getStats() const;
+    void resetStats();
+
+private:
+    static constexpr size_t HISTORY = 1 << 12;
+
+    int targetFps;
+    int64_t periodNs;
+    int64_t deadlineNs;
+    int64_t lastFrameNs;
+    std::vector<int64_t> intervals;
+    size_t intervalCount;
+    void* timer; // Win32 waitable timer; unused elsewhere
+    bool raisedTimerResolution;
+
+    void sleepUntil(int64_t targetNs);
+};
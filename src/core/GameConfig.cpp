@@ -0,0 +1,42 @@
+#include "GameConfig.h"
+#include <cstdlib>
+#include <cstring>
+
+GameConfig GameConfig::parseCommandLine(int argc, char* argv[]) {
+    GameConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--width") == 0 && i + 1 < argc) config.windowWidth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && i + 1 < argc) config.windowHeight = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fullscreen") == 0) config.fullscreen = true;
+        else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) config.difficulty = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) config.playerSpeed = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--debug") == 0) config.debugMode = true;
+        else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) config.tickRate = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) config.targetFps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--uncapped") == 0) config.targetFps = 0;
+        else if (strcmp(argv[i], "--render-threads") == 0 && i + 1 < argc) config.renderThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--archive") == 0 && i + 1 < argc) config.assetArchive = argv[++i];
+        else if (strcmp(argv[i], "--no-archive") == 0) config.assetArchive.clear();
+        else if (strcmp(argv[i], "--platform-pool") == 0 && i + 1 < argc) config.platformPoolCapacity = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--enemy-pool") == 0 && i + 1 < argc) config.enemyPoolCapacity = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--projectile-pool") == 0 && i + 1 < argc) config.projectilePoolCapacity = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--enemy-chance") == 0 && i + 1 < argc) config.enemySpawnChance = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--disappear-chance") == 0 && i + 1 < argc) config.platformDisappearingChance = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--min-interval") == 0 && i + 1 < argc) config.minPlatformInterval = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-interval") == 0 && i + 1 < argc) config.maxPlatformInterval = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jetpack-chance") == 0 && i + 1 < argc) config.jetpackSpawnChance = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--no-level-thread") == 0) config.levelThread = false;
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) config.recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) config.replayPath = argv[++i];
+        else if (strcmp(argv[i], "--agent") == 0 && i + 1 < argc) config.agent = argv[++i];
+        else if (strcmp(argv[i], "--agent-reaction") == 0 && i + 1 < argc) config.agentReactionMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--agent-error") == 0 && i + 1 < argc) config.agentAimError = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--agent-lapse-chance") == 0 && i + 1 < argc) config.agentLapseChance = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--agent-lapse") == 0 && i + 1 < argc) config.agentLapseMs = atoi(argv[++i]);
+    }
+    if (config.tickRate <= 0) config.tickRate = GameConstants::DEFAULT_TICK_RATE;
+    if (config.maxPlatformInterval < config.minPlatformInterval) config.maxPlatformInterval = config.minPlatformInterval;
+    return config;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace GameConstants {
+    constexpr int SCREEN_WIDTH = 600;
+    constexpr int SCREEN_HEIGHT = 800;
+    constexpr int DEFAULT_TICK_RATE = 60; // also stands in for a tick rate that isn't positive
+
+    constexpr float GRAVITY = 600.0f;
+    constexpr float JUMP_FORCE = -500.0f;
+    constexpr float BASE_PLAYER_SPEED = 100.0f;
+    constexpr float MAX_FALL_SPEED = 400.0f;
+
+    constexpr int PLAYER_WIDTH = 74;
+    constexpr int PLAYER_FULL_WIDTH = 124;
+    constexpr int PLAYER_HEIGHT = 120;
+
+    constexpr int PLATFORM_WIDTH = 114;
+    constexpr int PLATFORM_HEIGHT = 30;
+    constexpr int MIN_PLATFORM_INTERVAL = 120;
+    constexpr int MAX_PLATFORM_INTERVAL = 210;
+    constexpr float PLATFORM_FADE_SPEED = 0.06f;
+    constexpr int INITIAL_PLATFORM_COUNT = 10;
+    constexpr int PLATFORM_DISAPPEARING_CHANCE = 15;
+
+    // Levels are generated in chunks this tall, and platforms are spawned
+    // once they come within LEVEL_SPAWN_AHEAD of the top of the view. Spacing
+    // and enemy odds reach their configured values after LEVEL_RAMP_CHUNKS
+    // chunks at difficulty 1.
+    constexpr int LEVEL_CHUNK_HEIGHT = 800;
+    constexpr float LEVEL_SPAWN_AHEAD = 400.0f;
+    constexpr float LEVEL_RAMP_CHUNKS = 8.0f;
+
+    constexpr int ENEMY_SPAWN_CHANCE = 10; // %
+    constexpr int ENEMY_TYPE_COUNT = 3;
+    constexpr int ENEMY_TYPE_WIDTH[ENEMY_TYPE_COUNT] = { 152, 71, 129 };
+    constexpr int ENEMY_TYPE_HEIGHT[ENEMY_TYPE_COUNT] = { 111, 94, 172 };
+
+    constexpr float PROJECTILE_SPEED = 1000.0f;
+    constexpr int PROJECTILE_WIDTH = 28;
+    constexpr int PROJECTILE_HEIGHT = 28;
+    constexpr int PROJECTILE_COOLDOWN = 300; // ms
+
+    // Default entity pool capacities. Everything is allocated up front; a
+    // spawn that finds its pool full is skipped and counted as exhaustion.
+    constexpr int PLATFORM_POOL_CAPACITY = 32;
+    constexpr int ENEMY_POOL_CAPACITY = 16;
+    constexpr int PROJECTILE_POOL_CAPACITY = 16;
+
+    // Broadphase rows: 64 rows of 64px cover the whole band of live entities
+    // (the view plus the platforms spawned ahead of it).
+    constexpr float BROADPHASE_ROW_HEIGHT = 64.0f;
+    constexpr int BROADPHASE_ROWS = 64;
+
+    constexpr int JETPACK_DURATION = 4000; // ms
+    constexpr float JETPACK_SPEED = 400.0f;
+    constexpr int JETPACK_WIDTH = 40;
+    constexpr int JETPACK_HEIGHT = 40;
+    constexpr int JETPACK_SPAWN_CHANCE = 5; // %
+}
+
+struct GameConfig {
+    int windowWidth = GameConstants::SCREEN_WIDTH;
+    int windowHeight = GameConstants::SCREEN_HEIGHT;
+    bool fullscreen = false;
+    float difficulty = 1.0f;
+    float playerSpeed = 5.0f;
+    bool debugMode = false;
+    int tickRate = GameConstants::DEFAULT_TICK_RATE; // simulation steps per second, independent of the frame rate
+    int targetFps = 60; // frame rate cap for the window; 0 runs uncapped
+    int renderThreads = 0; // threads compositing each frame; 0 uses every hardware thread
+    std::string assetArchive = "material.pak"; // pre-decoded sprites; empty or missing loads the loose files
+    int platformPoolCapacity = GameConstants::PLATFORM_POOL_CAPACITY;
+    int enemyPoolCapacity = GameConstants::ENEMY_POOL_CAPACITY;
+    int projectilePoolCapacity = GameConstants::PROJECTILE_POOL_CAPACITY;
+    // Level tuning, exposed for batch balancing runs. Route spacing ramps from
+    // the minimum interval up to the maximum, which the level generator clamps
+    // to what the jump clears.
+    int enemySpawnChance = GameConstants::ENEMY_SPAWN_CHANCE; // %
+    int platformDisappearingChance = GameConstants::PLATFORM_DISAPPEARING_CHANCE; // %
+    int minPlatformInterval = GameConstants::MIN_PLATFORM_INTERVAL;
+    int maxPlatformInterval = GameConstants::MAX_PLATFORM_INTERVAL;
+    int jetpackSpawnChance = 0; // % of route platforms; off until there is jetpack art
+    bool levelThread = true;    // generate level chunks ahead on a worker thread
+    uint64_t seed = 1; // same seed + same input = same run
+    std::string recordPath; // --record: write the session's input here on exit
+    std::string replayPath; // --replay: drive the session from this recording
+    std::string agent;      // --agent: "heuristic" or "scripted"; empty for a human player
+    // How the heuristic agent falls short of perfect play; see HeuristicBotSkill.
+    int agentReactionMs = 150;
+    float agentAimError = 40.0f;    // px
+    int agentLapseChance = 2;       // %
+    int agentLapseMs = 3000;
+
+    static GameConfig parseCommandLine(int argc, char* argv[]);
+};
\ No newline at end of file
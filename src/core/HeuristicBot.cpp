@@ -0,0 +1,107 @@
+#include "HeuristicBot.h"
+#include "GameConfig.h"
+#include <cmath>
+
+namespace {
+    constexpr float DEADBAND = 10.0f;
+    // A fading platform with less opacity than this may be gone before the
+    // player gets there: four seconds of fading, which World::step applies
+    // twice per step.
+    constexpr float MIN_OPACITY = GameConstants::PLATFORM_FADE_SPEED * 2 * 4.0f;
+
+    bool isSafe(const ObservedEntity& platform) { return !platform.disappearing || platform.opacity >= MIN_OPACITY; }
+}
+
+HeuristicBot::HeuristicBot(uint64_t seed, const HeuristicBotSkill& botSkill)
+    : rng(seed, static_cast<uint64_t>(RandomStream::Agent))
+    , skill(botSkill)
+{}
+
+// Normal (Box-Muller), so a rare wild miss is possible at any aimError.
+float HeuristicBot::drawAimError() {
+    float u = 1.0f - rng.nextFloat();
+    float angle = 6.2831853f * rng.nextFloat();
+    return skill.aimError * std::sqrt(-2.0f * std::log(u)) * std::cos(angle);
+}
+
+// While rising, the highest platform the top of the jump still clears, so the
+// player is already lined up when it turns; while falling, the nearest one
+// below the feet. Platforms about to fade out are only used when nothing else
+// is in reach.
+const ObservedEntity* HeuristicBot::pickPlatform(const Observation& o) const {
+    float feet = o.playerY + GameConstants::PLAYER_HEIGHT;
+    bool falling = o.velocityY > 0;
+    float apex = falling ? feet : feet - o.velocityY * o.velocityY / (2.0f * GameConstants::GRAVITY);
+    const ObservedEntity* best = nullptr;
+    const ObservedEntity* fallback = nullptr;
+    for (size_t i = 0; i < o.platformCount; ++i) {
+        const ObservedEntity& p = o.platforms[i];
+        if (p.y < apex) continue;
+        if (!falling && p.y >= feet) continue;
+        const ObservedEntity*& slot = isSafe(p) ? best : fallback;
+        // The highest one above the apex or, when falling, the nearest one below.
+        if (!slot || p.y < slot->y) slot = &p;
+    }
+    if (!best && !fallback && !falling) {
+        // Nothing above is in reach: line up with where the player will land.
+        for (size_t i = 0; i < o.platformCount; ++i) {
+            const ObservedEntity& p = o.platforms[i];
+            if (p.y < feet) continue;
+            const ObservedEntity*& slot = isSafe(p) ? best : fallback;
+            if (!slot || p.y < slot->y) slot = &p;
+        }
+    }
+    return best ? best : fallback;
+}
+
+// Enemies overlapping the player's column come first, then the nearest one on
+// screen. Anything below the feet can no longer be reached.
+const ObservedEntity* HeuristicBot::pickEnemy(const Observation& o) const {
+    float feet = o.playerY + GameConstants::PLAYER_HEIGHT;
+    float left = o.playerX;
+    float right = o.playerX + GameConstants::PLAYER_WIDTH;
+    const ObservedEntity* nearest = nullptr;
+    for (size_t i = 0; i < o.enemyCount; ++i) {
+        const ObservedEntity& e = o.enemies[i];
+        if (e.y > feet || e.y + e.height < o.cameraY) continue;
+        if (e.x <= right && e.x + e.width >= left) return &e;
+        if (!nearest) nearest = &e;
+    }
+    return nearest;
+}
+
+AgentAction HeuristicBot::act(const Observation& o) {
+    AgentAction action;
+
+    if (const ObservedEntity* target = pickPlatform(o)) {
+        // Until the reaction time is up the player keeps going as before. A
+        // lapse, exponentially long, keeps it bouncing where it is, long
+        // enough at times for a fading platform to go.
+        if (!hasTarget || target->x != targetX || target->y != targetY) {
+            hasTarget = true;
+            targetX = target->x;
+            targetY = target->y;
+            aimOffset = drawAimError();
+            reactTick = o.tick + static_cast<uint32_t>(skill.reactionTicks);
+            if (o.tick >= lapseEnd && rng.chance(skill.lapseChance))
+                lapseEnd = o.tick + static_cast<uint32_t>(-std::log(1.0f - rng.nextFloat()) * skill.lapseTicks);
+        }
+        if (o.tick < lapseEnd) action.move = MoveAction::Stop;
+        else if (o.tick >= reactTick) {
+            float playerCenter = o.playerX + GameConstants::PLAYER_WIDTH / 2.0f;
+            float targetCenter = target->x + target->width / 2.0f + aimOffset;
+            if (targetCenter < playerCenter - DEADBAND) action.move = MoveAction::Left;
+            else if (targetCenter > playerCenter + DEADBAND) action.move = MoveAction::Right;
+            else action.move = MoveAction::Stop;
+        }
+    }
+
+    if (o.canShoot) {
+        if (const ObservedEntity* enemy = pickEnemy(o)) {
+            action.shoot = true;
+            action.targetX = enemy->x + enemy->width / 2.0f + drawAimError();
+            action.targetY = enemy->y + enemy->height / 2.0f + drawAimError();
+        }
+    }
+    return action;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Agent.h"
+#include "Random.h"
+
+// How far the heuristic agent falls short of a perfect controller.
+struct HeuristicBotSkill {
+    int reactionTicks = 0;  // a new target goes unanswered this long
+    float aimError = 0.0f;  // standard deviation of every aim, px
+    int lapseChance = 0;    // % of new targets that find it distracted
+    int lapseTicks = 0;     // mean length of a lapse
+};
+
+// The default workload for benchmarks and soak runs. Steers under the next
+// solid platform, stepping around ones that are fading away, and shoots the
+// enemy closest to the player's path whenever the shot is off cooldown. It
+// plays like a person rather than a perfect controller: it reacts late, aims
+// off by a random amount and now and then stalls where it is, so games end and
+// batch runs see how hard the level is.
+class HeuristicBot : public Agent {
+public:
+    HeuristicBot(uint64_t seed, const HeuristicBotSkill& skill);
+
+    const char* getName() const override { return "heuristic"; }
+    AgentAction act(const Observation& observation) override;
+
+private:
+    Pcg32 rng;
+    HeuristicBotSkill skill;
+    bool hasTarget = false;
+    float targetX = 0.0f;   // the platform being steered for
+    float targetY = 0.0f;
+    float aimOffset = 0.0f;
+    uint32_t reactTick = 0; // first tick that steers for it
+    uint32_t lapseEnd = 0;  // holds still until this tick
+
+    const ObservedEntity* pickPlatform(const Observation& o) const;
+    const ObservedEntity* pickEnemy(const Observation& o) const;
+    float drawAimError();
+};
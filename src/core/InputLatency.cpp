@@ -0,0 +1,76 @@
+#include "InputLatency.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+InputLatencyTracker::InputLatencyTracker() : buckets(BUCKET_COUNT, 0), log(LOG_CAPACITY) {}
+
+uint64_t InputLatencyTracker::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void InputLatencyTracker::applied(const TimedInputEvent& input, uint32_t visibleTick) {
+    if (!pending.push({ input.capturedNs, visibleTick, input.event.type })) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void InputLatencyTracker::presented(uint32_t shownTick, uint32_t frame, uint64_t presentNs) {
+    for (;;) {
+        if (!holding && !pending.pop(held)) return;
+        // Events wait here until a frame shows the tick they took effect in.
+        holding = held.tick > shownTick;
+        if (holding) return;
+
+        uint64_t latency = presentNs > held.capturedNs ? presentNs - held.capturedNs : 0;
+        ++buckets[std::min<uint64_t>(latency / BUCKET_NS, BUCKET_COUNT - 1)];
+        log[events % LOG_CAPACITY] = { held.capturedNs, latency, held.tick, frame, held.type };
+        ++events;
+        maxNs = std::max(maxNs, latency);
+    }
+}
+
+// Upper edge of the bucket holding the given share of events.
+double InputLatencyTracker::percentile(double fraction) const {
+    size_t rank = static_cast<size_t>(fraction * (events - 1) + 0.5);
+    size_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += static_cast<size_t>(buckets[i]);
+        if (seen > rank) return std::min((i + 1) * BUCKET_NS, maxNs) / 1e6;
+    }
+    return maxNs / 1e6;
+}
+
+InputLatencyStats InputLatencyTracker::getStats() const {
+    InputLatencyStats stats;
+    stats.events = events;
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    if (events == 0) return stats;
+    stats.p50Ms = percentile(0.50);
+    stats.p95Ms = percentile(0.95);
+    stats.p99Ms = percentile(0.99);
+    stats.maxMs = maxNs / 1e6;
+    return stats;
+}
+
+bool InputLatencyTracker::writeHistogram(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "from_ms,to_ms,events\n");
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (i + 1 < BUCKET_COUNT) fprintf(file, "%.2f,%.2f,%llu\n", i * BUCKET_NS / 1e6, (i + 1) * BUCKET_NS / 1e6, static_cast<unsigned long long>(buckets[i]));
+        else fprintf(file, "%.2f,,%llu\n", i * BUCKET_NS / 1e6, static_cast<unsigned long long>(buckets[i]));
+    }
+    return fclose(file) == 0;
+}
+
+bool InputLatencyTracker::writeSamples(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "captured_ns,type,tick,frame,latency_ms\n");
+    size_t first = events > LOG_CAPACITY ? events - LOG_CAPACITY : 0;
+    for (size_t i = first; i < events; ++i) {
+        const InputLatencySample& s = log[i % LOG_CAPACITY];
+        fprintf(file, "%llu,%u,%u,%u,%.3f\n", static_cast<unsigned long long>(s.capturedNs), static_cast<unsigned>(s.type), s.tick, s.frame, s.latencyNs / 1e6);
+    }
+    return fclose(file) == 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "InputRecording.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Window input on its way to the simulation, stamped when the window thread
+// received it.
+struct TimedInputEvent {
+    InputEvent event;
+    uint64_t capturedNs = 0; // steady_clock
+};
+
+struct InputLatencySample {
+    uint64_t capturedNs;
+    uint64_t latencyNs;     // capture to present
+    uint32_t tick;          // first snapshot that shows the event's effect
+    uint32_t frame;         // frame that presented that snapshot
+    InputEventType type;
+};
+
+struct InputLatencyStats {
+    size_t events = 0;
+    size_t dropped = 0;     // applied while the hand-off to the window thread was full
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Input-to-present latency of live input. The simulation thread reports each
+// event as it applies it, along with the tick whose snapshot first reflects
+// it; the window thread reports every frame it presents and the snapshot tick
+// that frame showed. An event's latency runs from its capture to the first
+// presented frame showing that tick or a later one. Everything but applied()
+// belongs to the window thread.
+class InputLatencyTracker {
+public:
+    static constexpr uint64_t BUCKET_NS = 250000;  // 0.25 ms
+    static constexpr size_t BUCKET_COUNT = 400;    // the last one takes everything past 100 ms
+    static constexpr size_t LOG_CAPACITY = 4096;   // most recent samples kept for export
+
+    InputLatencyTracker();
+
+    static uint64_t now();
+
+    // Simulation thread.
+    void applied(const TimedInputEvent& input, uint32_t visibleTick);
+    // Window thread, right after the frame is on screen.
+    void presented(uint32_t shownTick, uint32_t frame, uint64_t presentNs);
+
+    InputLatencyStats getStats() const;
+    // Histogram as CSV rows of bucket bounds and counts.
+    bool writeHistogram(const char* path) const;
+    // The logged samples, oldest first.
+    bool writeSamples(const char* path) const;
+
+private:
+    struct Pending {
+        uint64_t capturedNs;
+        uint32_t tick;
+        InputEventType type;
+    };
+
+    SpscQueue<Pending, 1024> pending;
+    std::atomic<size_t> dropped{ 0 };
+    Pending held = {};      // popped but not yet shown
+    bool holding = false;
+
+    std::vector<uint64_t> buckets;
+    std::vector<InputLatencySample> log;
+    size_t events = 0;
+    uint64_t maxNs = 0;
+
+    double percentile(double fraction) const;
+};
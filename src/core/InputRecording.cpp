@@ -0,0 +1,287 @@
+#include "InputRecording.h"
+#include "World.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // File layout, little endian: "DJRP", u16 version, the fixed header, then
+    // varint counts followed by delta-coded events and checkpoints.
+    constexpr char MAGIC[4] = { 'D', 'J', 'R', 'P' };
+    constexpr uint16_t VERSION = 4;
+
+    class ByteWriter {
+    public:
+        std::vector<uint8_t> bytes;
+
+        void u8(uint8_t v) { bytes.push_back(v); }
+        void fixed(uint64_t v, int size) { for (int i = 0; i < size; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+        void f32(float v) { uint32_t bits; std::memcpy(&bits, &v, sizeof(bits)); fixed(bits, 4); }
+        void varint(uint64_t v) {
+            while (v >= 0x80) { bytes.push_back(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+            bytes.push_back(static_cast<uint8_t>(v));
+        }
+        void zigzag(int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+    };
+
+    class ByteReader {
+    private:
+        const std::vector<uint8_t>& bytes;
+        size_t position = 0;
+
+    public:
+        bool ok = true;
+
+        explicit ByteReader(const std::vector<uint8_t>& data) : bytes(data) {}
+
+        uint8_t u8() {
+            if (position >= bytes.size()) { ok = false; return 0; }
+            return bytes[position++];
+        }
+        uint64_t fixed(int size) {
+            uint64_t v = 0;
+            for (int i = 0; i < size; ++i) v |= static_cast<uint64_t>(u8()) << (8 * i);
+            return v;
+        }
+        float f32() { uint32_t bits = static_cast<uint32_t>(fixed(4)); float v; std::memcpy(&v, &bits, sizeof(v)); return v; }
+        uint64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64 && ok; shift += 7) {
+                uint8_t b = u8();
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+        int64_t zigzag() { uint64_t v = varint(); return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+    };
+
+    bool hasPosition(InputEventType type) { return type == InputEventType::MouseMove; }
+    bool hasCode(InputEventType type) { return type != InputEventType::MouseMove && type != InputEventType::GameReset; }
+
+    std::string describeMismatch(uint32_t tick, uint64_t expected, uint64_t actual) {
+        char message[128];
+        snprintf(message, sizeof(message), "tick %u: expected state %016llx, got %016llx", tick,
+            static_cast<unsigned long long>(expected), static_cast<unsigned long long>(actual));
+        return message;
+    }
+}
+
+void InputTranslator::apply(const InputEvent& event, World& world) {
+    switch (event.type) {
+    case InputEventType::KeyPressed:
+        if (event.code == static_cast<uint8_t>(InputKey::Left)) world.applyCommand({ CommandType::MoveLeft });
+        else if (event.code == static_cast<uint8_t>(InputKey::Right)) world.applyCommand({ CommandType::MoveRight });
+        break;
+    case InputEventType::KeyReleased:
+        if (event.code == static_cast<uint8_t>(InputKey::Left)) world.applyCommand({ CommandType::ReleaseLeft });
+        else if (event.code == static_cast<uint8_t>(InputKey::Right)) world.applyCommand({ CommandType::ReleaseRight });
+        break;
+    case InputEventType::MouseMove:
+        mouseX = event.x;
+        mouseY = event.y;
+        break;
+    case InputEventType::MouseButton:
+        if (!event.released && event.code == static_cast<uint8_t>(InputMouseButton::Left))
+            world.applyCommand({ CommandType::Shoot, static_cast<float>(mouseX), mouseY + world.getCameraY() });
+        break;
+    case InputEventType::GameReset:
+        break;
+    }
+}
+
+void InputRecording::begin(const GameConfig& config, int worldWidth, int worldHeight) {
+    seed = config.seed;
+    tickRate = config.tickRate;
+    width = worldWidth;
+    height = worldHeight;
+    playerSpeed = config.playerSpeed;
+    difficulty = config.difficulty;
+    platformPoolCapacity = config.platformPoolCapacity;
+    enemyPoolCapacity = config.enemyPoolCapacity;
+    projectilePoolCapacity = config.projectilePoolCapacity;
+    enemySpawnChance = config.enemySpawnChance;
+    platformDisappearingChance = config.platformDisappearingChance;
+    minPlatformInterval = config.minPlatformInterval;
+    maxPlatformInterval = config.maxPlatformInterval;
+    jetpackSpawnChance = config.jetpackSpawnChance;
+    events.clear();
+    checkpoints.clear();
+    finalTick = 0;
+    finalScore = 0;
+}
+
+void InputRecording::afterStep(uint32_t tick, const World& world) {
+    if (tick % CHECKPOINT_INTERVAL == 0) checkpoints.push_back({ tick, world.computeStateHash() });
+}
+
+void InputRecording::finish(uint32_t tick, const World& world) {
+    finalTick = tick;
+    finalScore = world.getScore();
+    // The last checkpoint comes after everything that happened on the final
+    // tick, a game over's reset included.
+    if (!checkpoints.empty() && checkpoints.back().tick == tick) checkpoints.back().hash = world.computeStateHash();
+    else checkpoints.push_back({ tick, world.computeStateHash() });
+}
+
+void InputRecording::applyTo(GameConfig& config) const {
+    config.seed = seed;
+    config.tickRate = tickRate;
+    config.windowWidth = width;
+    config.windowHeight = height;
+    config.fullscreen = false;
+    config.playerSpeed = playerSpeed;
+    config.difficulty = difficulty;
+    config.platformPoolCapacity = platformPoolCapacity;
+    config.enemyPoolCapacity = enemyPoolCapacity;
+    config.projectilePoolCapacity = projectilePoolCapacity;
+    config.enemySpawnChance = enemySpawnChance;
+    config.platformDisappearingChance = platformDisappearingChance;
+    config.minPlatformInterval = minPlatformInterval;
+    config.maxPlatformInterval = maxPlatformInterval;
+    config.jetpackSpawnChance = jetpackSpawnChance;
+}
+
+bool InputRecording::save(const char* path) const {
+    ByteWriter out;
+    for (char c : MAGIC) out.u8(static_cast<uint8_t>(c));
+    out.fixed(VERSION, 2);
+    out.fixed(seed, 8);
+    out.fixed(static_cast<uint32_t>(tickRate), 4);
+    out.fixed(static_cast<uint32_t>(width), 4);
+    out.fixed(static_cast<uint32_t>(height), 4);
+    out.f32(playerSpeed);
+    out.f32(difficulty);
+    out.fixed(static_cast<uint32_t>(platformPoolCapacity), 4);
+    out.fixed(static_cast<uint32_t>(enemyPoolCapacity), 4);
+    out.fixed(static_cast<uint32_t>(projectilePoolCapacity), 4);
+    out.fixed(static_cast<uint32_t>(enemySpawnChance), 4);
+    out.fixed(static_cast<uint32_t>(platformDisappearingChance), 4);
+    out.fixed(static_cast<uint32_t>(minPlatformInterval), 4);
+    out.fixed(static_cast<uint32_t>(maxPlatformInterval), 4);
+    out.fixed(static_cast<uint32_t>(jetpackSpawnChance), 4);
+    out.fixed(finalTick, 4);
+    out.fixed(static_cast<uint32_t>(finalScore), 4);
+
+    out.varint(events.size());
+    uint32_t lastTick = 0, lastTime = 0;
+    for (const InputEvent& e : events) {
+        out.varint(e.tick - lastTick);
+        out.varint(e.timeMs - lastTime);
+        out.u8(static_cast<uint8_t>(e.type));
+        if (hasCode(e.type)) out.u8(static_cast<uint8_t>(e.code | (e.released ? 0x80 : 0)));
+        if (hasPosition(e.type)) { out.zigzag(e.x); out.zigzag(e.y); }
+        lastTick = e.tick;
+        lastTime = e.timeMs;
+    }
+
+    out.varint(checkpoints.size());
+    lastTick = 0;
+    for (const StateCheckpoint& c : checkpoints) {
+        out.varint(c.tick - lastTick);
+        out.fixed(c.hash, 8);
+        lastTick = c.tick;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool written = fwrite(out.bytes.data(), 1, out.bytes.size(), file) == out.bytes.size();
+    return fclose(file) == 0 && written;
+}
+
+bool InputRecording::load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    std::vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + read);
+    fclose(file);
+
+    ByteReader in(bytes);
+    for (char c : MAGIC) if (in.u8() != static_cast<uint8_t>(c)) return false;
+    if (in.fixed(2) != VERSION) return false;
+    seed = in.fixed(8);
+    tickRate = static_cast<int32_t>(in.fixed(4));
+    if (tickRate <= 0) return false;
+    width = static_cast<int32_t>(in.fixed(4));
+    height = static_cast<int32_t>(in.fixed(4));
+    playerSpeed = in.f32();
+    difficulty = in.f32();
+    platformPoolCapacity = static_cast<int32_t>(in.fixed(4));
+    enemyPoolCapacity = static_cast<int32_t>(in.fixed(4));
+    projectilePoolCapacity = static_cast<int32_t>(in.fixed(4));
+    enemySpawnChance = static_cast<int32_t>(in.fixed(4));
+    platformDisappearingChance = static_cast<int32_t>(in.fixed(4));
+    minPlatformInterval = static_cast<int32_t>(in.fixed(4));
+    maxPlatformInterval = static_cast<int32_t>(in.fixed(4));
+    jetpackSpawnChance = static_cast<int32_t>(in.fixed(4));
+    finalTick = static_cast<uint32_t>(in.fixed(4));
+    finalScore = static_cast<int32_t>(in.fixed(4));
+
+    uint64_t eventCount = in.varint();
+    if (!in.ok || eventCount > bytes.size()) return false;
+    events.assign(static_cast<size_t>(eventCount), InputEvent());
+    uint32_t tick = 0, time = 0;
+    for (InputEvent& e : events) {
+        tick += static_cast<uint32_t>(in.varint());
+        time += static_cast<uint32_t>(in.varint());
+        e.tick = tick;
+        e.timeMs = time;
+        e.type = static_cast<InputEventType>(in.u8());
+        if (e.type > InputEventType::GameReset) return false;
+        if (hasCode(e.type)) {
+            uint8_t code = in.u8();
+            e.code = code & 0x7F;
+            e.released = (code & 0x80) != 0;
+        }
+        if (hasPosition(e.type)) {
+            e.x = static_cast<int32_t>(in.zigzag());
+            e.y = static_cast<int32_t>(in.zigzag());
+        }
+    }
+
+    uint64_t checkpointCount = in.varint();
+    if (!in.ok || checkpointCount > bytes.size()) return false;
+    checkpoints.assign(static_cast<size_t>(checkpointCount), StateCheckpoint());
+    tick = 0;
+    for (StateCheckpoint& c : checkpoints) {
+        tick += static_cast<uint32_t>(in.varint());
+        c.tick = tick;
+        c.hash = in.fixed(8);
+    }
+    return in.ok;
+}
+
+bool ReplayCursor::afterStep(uint32_t tick, const World& world) {
+    // The final tick's checkpoint is left to finish().
+    if (tick >= recording.finalTick) return !hasDiverged();
+    return check(tick, world);
+}
+
+bool ReplayCursor::check(uint32_t tick, const World& world) {
+    if (hasDiverged()) return false;
+    while (nextCheckpoint < recording.checkpoints.size() && recording.checkpoints[nextCheckpoint].tick < tick) ++nextCheckpoint;
+    if (nextCheckpoint == recording.checkpoints.size() || recording.checkpoints[nextCheckpoint].tick != tick) return true;
+
+    uint64_t hash = world.computeStateHash();
+    if (hash != recording.checkpoints[nextCheckpoint].hash) {
+        error = describeMismatch(tick, recording.checkpoints[nextCheckpoint].hash, hash);
+        return false;
+    }
+    ++nextCheckpoint;
+    return true;
+}
+
+bool ReplayCursor::finish(uint32_t tick, const World& world) {
+    if (!check(tick, world)) return false;
+    if (tick != recording.finalTick) {
+        error = "replay ended at tick " + std::to_string(tick) + ", recording at " + std::to_string(recording.finalTick);
+        return false;
+    }
+    if (world.getScore() != recording.finalScore) {
+        error = "final score " + std::to_string(world.getScore()) + ", recorded " + std::to_string(recording.finalScore);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include "GameConfig.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class World;
+
+// Raw client input as the framework delivers it. Codes mirror FRKey and
+// FRMouseButton so the core stays independent of the framework.
+enum class InputEventType : uint8_t {
+    KeyPressed,
+    KeyReleased,
+    MouseMove,
+    MouseButton,
+    GameReset   // the client restarted the World after a game over
+};
+
+enum class InputKey : uint8_t {
+    Right,
+    Left,
+    Down,
+    Up
+};
+
+enum class InputMouseButton : uint8_t {
+    Left,
+    Middle,
+    Right
+};
+
+struct InputEvent {
+    uint32_t tick = 0;      // simulation steps completed when the event arrived
+    uint32_t timeMs = 0;    // wall time since recording started; informational only
+    InputEventType type = InputEventType::KeyPressed;
+    uint8_t code = 0;       // InputKey or InputMouseButton
+    bool released = false;
+    int32_t x = 0;          // mouse position in screen coordinates
+    int32_t y = 0;
+};
+
+struct StateCheckpoint {
+    uint32_t tick;
+    uint64_t hash;
+};
+
+// Turns client input into World commands. The shoot target is the mouse
+// position moved into world space with the camera at the time of the click.
+class InputTranslator {
+private:
+    int mouseX = 0;
+    int mouseY = 0;
+
+public:
+    void apply(const InputEvent& event, World& world);
+};
+
+// A recorded session: the configuration that shapes the simulation, every
+// input event tagged with the tick it landed on, and World state hashes taken
+// at fixed tick intervals. Replaying the events at the same ticks from the
+// same seed must reproduce every checkpoint.
+class InputRecording {
+public:
+    static constexpr uint32_t CHECKPOINT_INTERVAL = 60;
+
+    uint64_t seed = 0;
+    int32_t tickRate = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    float playerSpeed = 0.0f;
+    float difficulty = 0.0f;
+    int32_t platformPoolCapacity = 0;
+    int32_t enemyPoolCapacity = 0;
+    int32_t projectilePoolCapacity = 0;
+    int32_t enemySpawnChance = 0;
+    int32_t platformDisappearingChance = 0;
+    int32_t minPlatformInterval = 0;
+    int32_t maxPlatformInterval = 0;
+    int32_t jetpackSpawnChance = 0;
+    std::vector<InputEvent> events;
+    std::vector<StateCheckpoint> checkpoints;
+    uint32_t finalTick = 0;
+    int32_t finalScore = 0;
+
+    void begin(const GameConfig& config, int worldWidth, int worldHeight);
+    void record(const InputEvent& event) { events.push_back(event); }
+    // Call after every step; keeps a checkpoint every CHECKPOINT_INTERVAL ticks.
+    void afterStep(uint32_t tick, const World& world);
+    void finish(uint32_t tick, const World& world);
+    // Overrides the config fields the recording was made with.
+    void applyTo(GameConfig& config) const;
+
+    bool save(const char* path) const;
+    bool load(const char* path);
+};
+
+// Walks a recording during replay: hands out the events due at each tick and
+// checks the World against the recorded checkpoints. The first mismatch is
+// kept in getError().
+class ReplayCursor {
+private:
+    const InputRecording& recording;
+    size_t nextEvent = 0;
+    size_t nextCheckpoint = 0;
+    std::string error;
+
+public:
+    explicit ReplayCursor(const InputRecording& rec) : recording(rec) {}
+
+    template <typename Fn>
+    void deliver(uint32_t tick, Fn&& fn) {
+        while (nextEvent < recording.events.size() && recording.events[nextEvent].tick <= tick) fn(recording.events[nextEvent++]);
+    }
+
+    bool afterStep(uint32_t tick, const World& world);
+    bool finish(uint32_t tick, const World& world);
+    bool isFinished(uint32_t tick) const { return tick >= recording.finalTick && nextEvent == recording.events.size(); }
+    bool hasDiverged() const { return !error.empty(); }
+    const std::string& getError() const { return error; }
+
+private:
+    bool check(uint32_t tick, const World& world);
+};
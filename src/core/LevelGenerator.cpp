@@ -0,0 +1,208 @@
+#include "LevelGenerator.h"
+#include "FixedTimestep.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace {
+    // Spacing is planned against this share of the jump's real reach, leaving
+    // slack for imperfect input.
+    constexpr float REACH_MARGIN = 0.9f;
+}
+
+LevelGenerator::LevelGenerator(const GameConfig& config, int worldWidth)
+    : width(worldWidth)
+    , enemyChance(config.enemySpawnChance)
+    , jetpackChance(config.jetpackSpawnChance)
+    , difficulty(std::max(config.difficulty, 0.0f))
+    , stepSeconds(FixedTimestep(config.tickRate).getStep())
+    , runSpeed(config.playerSpeed * GameConstants::BASE_PLAYER_SPEED)
+{
+    // Rise of a jump as Player::update integrates it at this tick rate.
+    float velocity = GameConstants::JUMP_FORCE;
+    float y = 0.0f;
+    float apex = 0.0f;
+    while (velocity < 0.0f) {
+        velocity = std::min(velocity + GameConstants::GRAVITY * stepSeconds, GameConstants::MAX_FALL_SPEED);
+        y += velocity * stepSeconds;
+        apex = std::min(apex, y);
+    }
+    jumpRise = -apex;
+    int reach = std::max(static_cast<int>(jumpRise * REACH_MARGIN), 1);
+    minInterval = std::clamp(config.minPlatformInterval, 1, reach);
+    maxInterval = std::clamp(config.maxPlatformInterval, minInterval, reach);
+}
+
+float LevelGenerator::getHorizontalReach(int interval) const {
+    float velocity = GameConstants::JUMP_FORCE;
+    float y = 0.0f;
+    float travelled = 0.0f;
+    while (velocity <= 0.0f || y < -interval) {
+        velocity = std::min(velocity + GameConstants::GRAVITY * stepSeconds, GameConstants::MAX_FALL_SPEED);
+        y += velocity * stepSeconds;
+        travelled += runSpeed * stepSeconds;
+    }
+    return travelled * REACH_MARGIN;
+}
+
+LevelCursor LevelGenerator::begin(uint64_t levelSeed, float startX, float startY) const {
+    LevelCursor cursor;
+    cursor.layoutRng.reseed(levelSeed, static_cast<uint64_t>(RandomStream::PlatformSpawn));
+    cursor.enemyRng.reseed(levelSeed, static_cast<uint64_t>(RandomStream::EnemySpawn));
+    cursor.pickupRng.reseed(levelSeed, static_cast<uint64_t>(RandomStream::PickupSpawn));
+    cursor.spinePlaced = 1; // the start platform
+    cursor.spineX = startX;
+    cursor.spineY = startY;
+    return cursor;
+}
+
+void LevelGenerator::generate(const LevelCursor& from, uint32_t epoch, LevelChunk& chunk) const {
+    DJ_PROFILE_ZONE("LevelGenerator::generate");
+    LevelCursor c = from;
+    chunk.epoch = epoch;
+    chunk.index = c.chunkIndex;
+    chunk.count = 0;
+
+    float ramp = std::min(1.0f, difficulty * c.chunkIndex / GameConstants::LEVEL_RAMP_CHUNKS);
+    int widest = minInterval + static_cast<int>((maxInterval - minInterval) * ramp);
+    int enemyOdds = static_cast<int>(enemyChance * (0.5f + 0.5f * ramp) + 0.5f);
+    float maxX = static_cast<float>(std::max(width - GameConstants::PLATFORM_WIDTH, 0));
+
+    float top = c.spineY - GameConstants::LEVEL_CHUNK_HEIGHT;
+    while (c.spineY > top && chunk.count + 2 <= LevelChunk::MAX_PLATFORMS) {
+        int interval = minInterval;
+        if (widest > minInterval) interval += static_cast<int>(c.layoutRng.nextBelow(static_cast<uint32_t>(widest - minInterval + 1)));
+        float reach = getHorizontalReach(interval);
+        float left = std::max(0.0f, c.spineX - reach);
+        float right = std::min(maxX, c.spineX + reach);
+        // The jump stays on the spine's side of every enemy its sweep reaches.
+        // Enemies are placed clear of the spine, so the spine's own x is
+        // always left in range.
+        float sweepTop = c.spineY - jumpRise - GameConstants::PLAYER_HEIGHT;
+        for (uint32_t i = 0; i < std::min(c.enemyCount, LevelCursor::HISTORY); ++i) {
+            const LevelBox& enemy = c.enemies[i];
+            if (enemy.top >= c.spineY || enemy.bottom <= sweepTop) continue;
+            if (enemy.left >= c.spineX + GameConstants::PLATFORM_WIDTH) right = std::min(right, enemy.left - ENEMY_CLEARANCE - GameConstants::PLATFORM_WIDTH);
+            else left = std::max(left, enemy.right + ENEMY_CLEARANCE);
+        }
+        right = std::max(right, left);
+        float x = left + static_cast<float>(c.layoutRng.nextBelow(static_cast<uint32_t>(right - left) + 1));
+        float y = c.spineY - interval;
+        c.jumps[c.jumpCount++ % LevelCursor::HISTORY] = { std::min(c.spineX, x), std::max(c.spineX, x) + GameConstants::PLATFORM_WIDTH, sweepTop, c.spineY };
+
+        bool early = c.spinePlaced < static_cast<uint32_t>(GameConstants::INITIAL_PLATFORM_COUNT);
+        uint8_t flags = CHUNK_SPINE;
+        if (!early && c.pickupRng.chance(jetpackChance)) flags |= CHUNK_JETPACK;
+        chunk.platforms[chunk.count++] = { x, y, -1, flags };
+        ++c.spinePlaced;
+        c.spineX = x;
+        c.spineY = y;
+
+        // The enemy gets a platform of its own on the roomier side of the spine.
+        if (early || !c.enemyRng.chance(enemyOdds)) continue;
+        int type = static_cast<int>(c.enemyRng.nextBelow(GameConstants::ENEMY_TYPE_COUNT));
+        float overhang = std::max(0.0f, (GameConstants::ENEMY_TYPE_WIDTH[type] - GameConstants::PLATFORM_WIDTH) / 2.0f);
+        float top = y - GameConstants::ENEMY_TYPE_HEIGHT[type];
+        // With very tight spacing the history may not reach back far enough
+        // to vouch for the spot; leave such a row empty.
+        const LevelBox& oldestJump = c.jumps[c.jumpCount % LevelCursor::HISTORY];
+        const LevelBox& oldestEnemy = c.enemies[c.enemyCount % LevelCursor::HISTORY];
+        if (c.jumpCount >= LevelCursor::HISTORY && oldestJump.top < y) continue;
+        if (c.enemyCount >= LevelCursor::HISTORY && oldestEnemy.top < y) continue;
+
+        // Clear of every jump whose sweep reaches the enemy's height, the one
+        // onto this row included, on whichever side leaves more room.
+        float rightLo = x + GameConstants::PLATFORM_WIDTH + ENEMY_CLEARANCE + overhang;
+        float leftHi = x - ENEMY_CLEARANCE - overhang - GameConstants::PLATFORM_WIDTH;
+        for (uint32_t i = 0; i < std::min(c.jumpCount, LevelCursor::HISTORY); ++i) {
+            const LevelBox& jump = c.jumps[i];
+            if (jump.top >= y || jump.bottom <= top) continue;
+            rightLo = std::max(rightLo, jump.right + ENEMY_CLEARANCE + overhang);
+            leftHi = std::min(leftHi, jump.left - ENEMY_CLEARANCE - overhang - GameConstants::PLATFORM_WIDTH);
+        }
+        bool onRight = maxX - overhang - rightLo > leftHi - overhang;
+        float lo = onRight ? rightLo : overhang;
+        float hi = onRight ? maxX - overhang : leftHi;
+        if (hi < lo) continue;
+        float enemyX = lo + static_cast<float>(c.enemyRng.nextBelow(static_cast<uint32_t>(hi - lo) + 1));
+        chunk.platforms[chunk.count++] = { enemyX, y, static_cast<int8_t>(type), 0 };
+        c.enemies[c.enemyCount++ % LevelCursor::HISTORY] = { enemyX - overhang, enemyX + GameConstants::PLATFORM_WIDTH + overhang, top, y };
+    }
+
+    ++c.chunkIndex;
+    chunk.next = c;
+}
+
+LevelStreamer::LevelStreamer(const LevelGenerator& gen, bool threaded) : generator(gen) {
+    if (threaded) worker = std::thread(&LevelStreamer::workerLoop, this);
+}
+
+LevelStreamer::~LevelStreamer() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void LevelStreamer::restart(const LevelCursor& start) {
+    cursor = start;
+    ++epoch;
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        workerStart = start;
+        workerEpoch = epoch;
+        restartPending = true;
+    }
+    wake.notify_one();
+}
+
+void LevelStreamer::next(LevelChunk& chunk) {
+    bool popped = false;
+    bool found = false;
+    while (queue.pop(chunk)) {
+        popped = true;
+        if (chunk.epoch == epoch && chunk.index == cursor.chunkIndex) { found = true; break; }
+        ++stats.discarded;
+    }
+    if (found) ++stats.streamed;
+    else {
+        generator.generate(cursor, epoch, chunk);
+        ++stats.generated;
+    }
+    cursor = chunk.next;
+
+    // Taking the mutex orders the pop before the worker's check for space.
+    if (popped && worker.joinable()) {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        wake.notify_one();
+    }
+}
+
+void LevelStreamer::workerLoop() {
+    LevelChunk chunk;
+    LevelCursor local;
+    uint32_t localEpoch = 0;
+    bool started = false;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || restartPending || (started && !queue.full()); });
+        if (stopping) return;
+        if (restartPending) {
+            local = workerStart;
+            localEpoch = workerEpoch;
+            restartPending = false;
+            started = true;
+        }
+
+        lock.unlock();
+        generator.generate(local, localEpoch, chunk);
+        lock.lock();
+        // A restart while generating makes this chunk stale before it is queued.
+        if (restartPending) continue;
+        queue.push(chunk);
+        local = chunk.next;
+    }
+}
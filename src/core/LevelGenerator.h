@@ -0,0 +1,144 @@
+#pragma once
+#include "GameConfig.h"
+#include "Random.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+enum ChunkPlatformFlags : uint8_t {
+    CHUNK_SPINE = 1 << 0,   // part of the guaranteed route; never carries an enemy
+    CHUNK_JETPACK = 1 << 1  // landing on it straps on a jetpack
+};
+
+struct ChunkPlatform {
+    float x, y;
+    int8_t enemyType;  // -1 for none
+    uint8_t flags;
+};
+
+// Columns and heights something on the level takes up: for a route jump, the
+// columns between its two platforms and the height the player's body sweeps;
+// for an enemy, its sprite and platform.
+struct LevelBox {
+    float left, right, top, bottom;
+};
+
+// Where generation stands after a chunk: everything the next chunk depends on.
+// A level is fully determined by its starting cursor.
+struct LevelCursor {
+    // Recent route jumps and enemies, kept so new ones stay clear of them
+    // across chunk boundaries. Anything older is too far below to matter.
+    static constexpr uint32_t HISTORY = 8;
+
+    Pcg32 layoutRng;
+    Pcg32 enemyRng;
+    Pcg32 pickupRng;
+    uint32_t chunkIndex = 0;
+    uint32_t spinePlaced = 0;
+    float spineX = 0.0f;
+    float spineY = 0.0f;
+    LevelBox jumps[HISTORY] = {};
+    LevelBox enemies[HISTORY] = {};
+    uint32_t jumpCount = 0;     // ring positions are count % HISTORY
+    uint32_t enemyCount = 0;
+};
+
+// One vertical slice of a level, platforms ordered bottom to top. Fixed size
+// so it moves through the queue without touching the heap.
+struct LevelChunk {
+    static constexpr int MAX_PLATFORMS = 32;
+
+    uint32_t epoch = 0;      // which level it belongs to; see LevelStreamer::restart
+    uint32_t index = 0;
+    int count = 0;
+    ChunkPlatform platforms[MAX_PLATFORMS];
+    LevelCursor next;        // cursor the following chunk starts from
+};
+
+// Lays out a level one chunk at a time. Each chunk climbs a spine of platforms
+// spaced no further apart than the jump can reach, vertically and sideways,
+// so the level can always be climbed without killing anything: enemies get
+// their own platform beside the spine, ENEMY_CLEARANCE away from every jump
+// that passes them. Platforms only start to fade once landed on, so nothing
+// ahead of the player is lost.
+// Platform spacing and enemy odds ramp from easy to the configured values
+// over the first chunks, faster at higher difficulty. Layout, enemies and
+// pickups draw from separate streams.
+class LevelGenerator {
+public:
+    // Clear space between an enemy and a route jump beside it: the player can
+    // hang this far over the platform edge.
+    static constexpr float ENEMY_CLEARANCE = GameConstants::PLAYER_WIDTH + 10.0f;
+
+    LevelGenerator(const GameConfig& config, int worldWidth);
+
+    LevelCursor begin(uint64_t levelSeed, float startX, float startY) const;
+    void generate(const LevelCursor& cursor, uint32_t epoch, LevelChunk& chunk) const;
+
+    int getMaxInterval() const { return maxInterval; }
+    // How far the feet rise above the platform a jump starts from.
+    float getJumpRise() const { return jumpRise; }
+    // Furthest the spine steps sideways across a gap of the given height.
+    float getHorizontalReach(int interval) const;
+
+private:
+    int width;
+    int minInterval;
+    int maxInterval;    // configured maximum, clamped to what the jump clears
+    int enemyChance;
+    int jetpackChance;
+    float difficulty;
+    float stepSeconds;
+    float runSpeed;
+    float jumpRise;
+};
+
+struct LevelStreamStats {
+    uint64_t streamed = 0;   // chunks the worker had ready in time
+    uint64_t generated = 0;  // chunks the simulation had to generate itself
+    uint64_t discarded = 0;  // stale chunks dropped after a restart or a miss
+};
+
+// Runs a LevelGenerator ahead of the simulation on its own thread and hands
+// the finished chunks over through a lock-free queue. The worker only sleeps
+// and wakes through the mutex; chunk data never goes through it. A chunk the
+// worker has not finished yet is generated on the spot from the same cursor,
+// so what the simulation sees never depends on thread timing.
+class LevelStreamer {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 4;
+
+    // Without a worker every chunk is generated on the caller's thread.
+    LevelStreamer(const LevelGenerator& generator, bool threaded);
+    ~LevelStreamer();
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // Starts a new level from cursor. Chunks still queued from the old one
+    // are recognised by their epoch and dropped.
+    void restart(const LevelCursor& cursor);
+    // Fills chunk with the level's next chunk.
+    void next(LevelChunk& chunk);
+
+    const LevelStreamStats& getStats() const { return stats; }
+
+private:
+    const LevelGenerator& generator;
+    SpscQueue<LevelChunk, QUEUE_CAPACITY> queue;
+    LevelCursor cursor;     // simulation side: where the next chunk starts
+    uint32_t epoch = 0;
+    LevelStreamStats stats;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    LevelCursor workerStart;
+    uint32_t workerEpoch = 0;
+    bool restartPending = false;
+    bool stopping = false;
+
+    void workerLoop();
+};
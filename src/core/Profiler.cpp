@@ -0,0 +1,168 @@
+#include "Profiler.h"
+
+#if DOODLE_PROFILE
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr size_t ZONE_CAPACITY = 1 << 16;
+    constexpr size_t FRAME_CAPACITY = 1 << 14;
+
+    struct ZoneEvent {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // Written only by its own thread; readers (summary, export) are expected to
+    // run once the recording threads have gone quiet.
+    struct ThreadBuffer {
+        uint32_t threadIndex;
+        std::vector<ZoneEvent> events;
+        std::atomic<uint64_t> written{ 0 };
+
+        explicit ThreadBuffer(uint32_t index) : threadIndex(index), events(ZONE_CAPACITY) {}
+    };
+
+    std::atomic<bool> enabled{ false };
+    std::mutex registryMutex;
+    // Buffers outlive their threads so a worker's zones can still be exported.
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::vector<uint64_t> frameTimes(FRAME_CAPACITY);
+    uint64_t frameCount = 0;
+    uint64_t lastFrameStart = 0;
+    const uint64_t epoch = Profiler::nowNanoseconds();
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(buffers.size())));
+            buffer = buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    template <typename Fn>
+    void forEachEvent(Fn fn) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : buffers) {
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = written > ZONE_CAPACITY ? written - ZONE_CAPACITY : 0;
+            for (uint64_t i = first; i < written; ++i) fn(*buffer, buffer->events[i % ZONE_CAPACITY]);
+        }
+    }
+
+    double percentile(std::vector<uint64_t>& sorted, double fraction) {
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[index] / 1e6;
+    }
+}
+
+void Profiler::setEnabled(bool on) {
+    if (on && !enabled.load()) lastFrameStart = 0;
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+uint64_t Profiler::nowNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % ZONE_CAPACITY] = { name, startNs, endNs };
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::markFrame() {
+    if (!isEnabled()) return;
+    uint64_t now = nowNanoseconds();
+    if (lastFrameStart) frameTimes[frameCount++ % FRAME_CAPACITY] = now - lastFrameStart;
+    lastFrameStart = now;
+}
+
+Profiler::FrameStats Profiler::getFrameStats() {
+    FrameStats stats;
+    size_t count = static_cast<size_t>(std::min<uint64_t>(frameCount, FRAME_CAPACITY));
+    if (count == 0) return stats;
+
+    std::vector<uint64_t> sorted(frameTimes.begin(), frameTimes.begin() + count);
+    std::sort(sorted.begin(), sorted.end());
+    stats.frames = count;
+    stats.p50Ms = percentile(sorted, 0.50);
+    stats.p95Ms = percentile(sorted, 0.95);
+    stats.p99Ms = percentile(sorted, 0.99);
+    stats.maxMs = sorted.back() / 1e6;
+    return stats;
+}
+
+void Profiler::printSummary() {
+    struct Total { uint64_t calls = 0; uint64_t ns = 0; };
+    // Keyed by text: the same literal can have a different address per translation unit.
+    std::map<std::string, Total> totals;
+    forEachEvent([&](const ThreadBuffer&, const ZoneEvent& e) {
+        Total& total = totals[e.name];
+        ++total.calls;
+        total.ns += e.end - e.start;
+    });
+
+    printf("%-24s %10s %12s %10s\n", "zone", "calls", "total ms", "avg us");
+    for (const auto& [name, total] : totals) {
+        printf("%-24s %10llu %12.2f %10.2f\n", name.c_str(), static_cast<unsigned long long>(total.calls),
+            total.ns / 1e6, total.ns / 1e3 / total.calls);
+    }
+
+    FrameStats frames = getFrameStats();
+    if (frames.frames) {
+        printf("frames: %zu, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+            frames.frames, frames.p50Ms, frames.p95Ms, frames.p99Ms, frames.maxMs);
+    }
+}
+
+bool Profiler::writeChromeTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"traceEvents\":[");
+    bool first = true;
+    forEachEvent([&](const ThreadBuffer& buffer, const ZoneEvent& e) {
+        fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            first ? "" : ",", e.name, buffer.threadIndex, (e.start - epoch) / 1e3, (e.end - e.start) / 1e3);
+        first = false;
+    });
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(file) == 0;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& buffer : buffers) buffer->written.store(0);
+    frameCount = 0;
+    lastFrameStart = 0;
+}
+
+#else
+
+void Profiler::setEnabled(bool) {}
+bool Profiler::isEnabled() { return false; }
+uint64_t Profiler::nowNanoseconds() { return 0; }
+void Profiler::recordZone(const char*, uint64_t, uint64_t) {}
+void Profiler::markFrame() {}
+Profiler::FrameStats Profiler::getFrameStats() { return FrameStats(); }
+void Profiler::printSummary() {}
+bool Profiler::writeChromeTrace(const char*) { return false; }
+void Profiler::reset() {}
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Scoped-zone profiler. Zones are recorded into a fixed ring buffer per thread
+// (the oldest events are overwritten), frame times into a separate ring, and
+// both can be dumped as Chrome trace-event JSON (chrome://tracing, Perfetto).
+// Recording is off until setEnabled(true); building with DOODLE_PROFILE=0
+// compiles the macros out entirely.
+//
+// Zone names must be string literals or otherwise outlive the profiler.
+#ifndef DOODLE_PROFILE
+#define DOODLE_PROFILE 1
+#endif
+
+namespace Profiler {
+    void setEnabled(bool enabled);
+    bool isEnabled();
+
+    uint64_t nowNanoseconds();
+    void recordZone(const char* name, uint64_t startNs, uint64_t endNs);
+    // Closes the current frame; the time since the previous call is a frame time.
+    void markFrame();
+
+    struct FrameStats {
+        size_t frames = 0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+    FrameStats getFrameStats();
+
+    // Per-zone totals and frame percentiles on stdout.
+    void printSummary();
+    bool writeChromeTrace(const char* path);
+    void reset();
+}
+
+#if DOODLE_PROFILE
+class ProfileZone {
+private:
+    const char* name;
+    uint64_t start;
+
+public:
+    explicit ProfileZone(const char* zoneName)
+        : name(zoneName)
+        , start(Profiler::isEnabled() ? Profiler::nowNanoseconds() : 0)
+    {}
+    ~ProfileZone() { if (start) Profiler::recordZone(name, start, Profiler::nowNanoseconds()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define DJ_PROFILE_CONCAT_INNER(a, b) a##b
+#define DJ_PROFILE_CONCAT(a, b) DJ_PROFILE_CONCAT_INNER(a, b)
+#define DJ_PROFILE_ZONE(name) ProfileZone DJ_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define DJ_PROFILE_FRAME() Profiler::markFrame()
+#else
+#define DJ_PROFILE_ZONE(name) ((void)0)
+#define DJ_PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+// PCG32 (O'Neill, pcg-random.org): 64-bit state, 32-bit output, and a
+// selectable stream so each subsystem can own an independent sequence from
+// the same seed. Small enough to copy around with the state it drives.
+class Pcg32 {
+private:
+    uint64_t state;
+    uint64_t increment;
+
+public:
+    explicit Pcg32(uint64_t seed = 0, uint64_t stream = 0) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        increment = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform in [0, bound) without modulo bias.
+    uint32_t nextBelow(uint32_t bound) {
+        if (bound == 0) return 0;
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            uint32_t r = next();
+            if (r >= threshold) return r % bound;
+        }
+    }
+
+    // True with the given percent probability.
+    bool chance(int percent) { return static_cast<int>(nextBelow(100)) < percent; }
+
+    // Uniform in [0, 1).
+    float nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// One stream per subsystem that draws random numbers, so adding a draw in one
+// place doesn't shift the sequence every other system sees.
+enum class RandomStream : uint64_t {
+    PlatformDisappear = 1,
+    PlatformSpawn,
+    EnemySpawn,
+    PickupSpawn,
+    Level,      // one seed per game; the level's own streams derive from it
+    Agent
+};
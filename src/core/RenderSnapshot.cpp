@@ -0,0 +1,41 @@
+#include "RenderSnapshot.h"
+#include "Profiler.h"
+#include "World.h"
+#include <chrono>
+
+namespace {
+    void copyStore(const EntityStore& store, std::vector<SnapshotEntity>& out) {
+        out.clear();
+        if (out.capacity() < store.getStats().capacity) out.reserve(store.getStats().capacity);
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (!store.isActive(i)) continue;
+            out.push_back({ store.prevX[i], store.prevY[i], store.x[i], store.y[i], store.value[i], store.variant[i] });
+        }
+    }
+}
+
+void captureSnapshot(const World& world, uint32_t tick, RenderSnapshot& snapshot) {
+    DJ_PROFILE_ZONE("captureSnapshot");
+    snapshot.tick = tick;
+    snapshot.publishedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    snapshot.prevCameraY = world.getPreviousCameraY();
+    snapshot.cameraY = world.getCameraY();
+    snapshot.gameOver = world.isGameOver();
+    snapshot.score = world.getScore();
+
+    const Player* player = world.getPlayer();
+    snapshot.hasPlayer = player != nullptr;
+    if (player) {
+        snapshot.player = { player->getPreviousX(), player->getPreviousY(), player->getX(), player->getY(), 0.0f, 0 };
+        snapshot.lookingUp = player->getLookingUp();
+        snapshot.falling = player->isFalling();
+        snapshot.lookingRight = player->isLookingToRight();
+        snapshot.noseAngle = player->getNoseAngle();
+        snapshot.platformsCount = player->getPlatformsCount();
+    }
+
+    copyStore(world.getPlatforms(), snapshot.platforms);
+    copyStore(world.getEnemies(), snapshot.enemies);
+    copyStore(world.getProjectiles(), snapshot.projectiles);
+}
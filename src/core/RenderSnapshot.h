@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class World;
+
+// Everything the client needs to draw one simulation step, copied out of the
+// World so rendering never touches live simulation state. Positions keep the
+// previous step too, for interpolation.
+struct SnapshotEntity {
+    float prevX, prevY;
+    float x, y;
+    float value;     // platforms: opacity
+    uint8_t variant; // enemies: type
+
+    float interpolatedX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float interpolatedY(float alpha) const { return prevY + (y - prevY) * alpha; }
+};
+
+struct RenderSnapshot {
+    uint32_t tick = 0;
+    uint64_t publishedNs = 0; // steady_clock time the step finished
+    float prevCameraY = 0.0f;
+    float cameraY = 0.0f;
+    bool gameOver = false;
+    int score = 0;
+
+    bool hasPlayer = false;
+    SnapshotEntity player = {};
+    bool lookingUp = false;
+    bool falling = false;
+    bool lookingRight = true;
+    float noseAngle = 0.0f;
+    int platformsCount = 0;
+
+    std::vector<SnapshotEntity> platforms;
+    std::vector<SnapshotEntity> enemies;
+    std::vector<SnapshotEntity> projectiles;
+
+    float interpolatedCameraY(float alpha) const { return prevCameraY + (cameraY - prevCameraY) * alpha; }
+};
+
+// Overwrites snapshot with world's current state. Inactive entities are left
+// out. The vectors are sized to the pool capacities the first time, so later
+// captures don't allocate.
+void captureSnapshot(const World& world, uint32_t tick, RenderSnapshot& snapshot);
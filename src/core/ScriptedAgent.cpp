@@ -0,0 +1,31 @@
+#include "ScriptedAgent.h"
+#include "GameConfig.h"
+
+AgentAction ScriptedAgent::act(const Observation& o) {
+    AgentAction action;
+    float feet = o.playerY + GameConstants::PLAYER_HEIGHT;
+    bool falling = o.velocityY > 0;
+
+    // Ties go to the earliest spawned platform, matching a scan of the store.
+    const ObservedEntity* target = nullptr;
+    for (size_t i = 0; i < o.platformCount; ++i) {
+        const ObservedEntity& p = o.platforms[i];
+        if (falling ? p.y < feet : p.y >= feet) continue;
+        if (!target || (falling ? p.y < target->y : p.y > target->y)) target = &p;
+    }
+
+    if (target) {
+        float playerCenter = o.playerX + GameConstants::PLAYER_WIDTH / 2.0f;
+        float targetCenter = target->x + target->width / 2.0f;
+        if (targetCenter < playerCenter - 10.0f) action.move = MoveAction::Left;
+        else if (targetCenter > playerCenter + 10.0f) action.move = MoveAction::Right;
+        else action.move = MoveAction::Stop;
+    }
+
+    if (o.canShoot) {
+        action.shoot = true;
+        action.targetX = o.playerX;
+        action.targetY = o.cameraY;
+    }
+    return action;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "Agent.h"
+
+// The original autopilot: while falling it steers toward the closest platform
+// below its feet, while rising toward the next one above, and fires straight
+// up whenever the shot is off cooldown.
+class ScriptedAgent : public Agent {
+public:
+    const char* getName() const override { return "scripted"; }
+    AgentAction act(const Observation& observation) override;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity must be a power of two; push() fails rather than blocks
+// when the queue is full.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head{ 0 }; // next slot to read
+    alignas(64) std::atomic<size_t> tail{ 0 }; // next slot to write
+
+public:
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    // Meaningful to the producer: the consumer can only make room.
+    bool full() const { return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == Capacity; }
+};
@@ -0,0 +1,91 @@
+#include "ThreadPool.h"
+
+namespace {
+    // Which pool and queue the current thread works for, so tasks that spawn
+    // more tasks keep them local.
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentQueue = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    for (size_t i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<WorkQueue>());
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = currentPool == this ? currentQueue : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        // Counted under wakeMutex, before the push, so a worker about to sleep
+        // can't miss it and the count never drops below the queued tasks.
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::popLocal(size_t index, Task& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkQueue& queue = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentQueue = index;
+
+    for (;;) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+        if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+    }
+}
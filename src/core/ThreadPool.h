@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool. Each worker owns a deque: it pushes and pops its own
+// work at the back, and idle workers steal from the front of the others, so
+// uneven task lengths (short and long games) still balance across cores.
+// Tasks submitted from outside the pool are dealt round-robin.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threadCount 0 uses one worker per hardware thread.
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    // Blocks until every submitted task has finished.
+    void wait();
+
+    size_t getThreadCount() const { return threads.size(); }
+    size_t getStealCount() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<size_t> queued{ 0 };
+    std::atomic<size_t> pending{ 0 };
+    std::atomic<size_t> nextQueue{ 0 };
+    std::atomic<size_t> steals{ 0 };
+    bool stopping = false;
+
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+    void workerLoop(size_t index);
+};
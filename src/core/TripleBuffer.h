@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer handoff of the latest value. The
+// writer fills writeBuffer() and publish()es it; the reader calls update()
+// and, if something newer arrived, sees it in readBuffer(). Neither side ever
+// waits: the writer always has a free slot and the reader keeps the last
+// value until a fresher one is published. Slots are reused, so a writer must
+// overwrite everything it cares about.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    T slots[3];
+    alignas(64) std::atomic<uint8_t> middle{ 0 };
+    alignas(64) uint8_t back = 1;   // writer only
+    alignas(64) uint8_t front = 2;  // reader only
+
+public:
+    T& writeBuffer() { return slots[back]; }
+    void publish() { back = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX_MASK; }
+
+    // Returns true if readBuffer() changed.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[front]; }
+};
@@ -0,0 +1,365 @@
+#include "World.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+World::World(const GameConfig& cfg, int worldWidth, int worldHeight)
+    : config(cfg)
+    , width(worldWidth)
+    , height(worldHeight)
+    , platformGrid(GameConstants::BROADPHASE_ROW_HEIGHT, GameConstants::BROADPHASE_ROWS)
+    , enemyGrid(GameConstants::BROADPHASE_ROW_HEIGHT, GameConstants::BROADPHASE_ROWS)
+    , time(0.0f)
+    , lastShotTime(0.0f)
+    , cameraY(0.0f)
+    , prevCameraY(0.0f)
+    , bonusScore(0)
+    , gameOver(false)
+    , generator(cfg, worldWidth)
+    , level(std::make_unique<LevelStreamer>(generator, cfg.levelThread))
+    , chunkNext(0)
+{
+    platforms.setCapacity(static_cast<size_t>(std::max(config.platformPoolCapacity, GameConstants::INITIAL_PLATFORM_COUNT)));
+    enemies.setCapacity(static_cast<size_t>(std::max(config.enemyPoolCapacity, 0)));
+    projectiles.setCapacity(static_cast<size_t>(std::max(config.projectilePoolCapacity, 0)));
+    // Rows are shorter than the platform spacing, so a few entries per bucket
+    // keep the broadphase from growing during play.
+    platformGrid.reserve(8);
+    enemyGrid.reserve(8);
+    reseed(config.seed);
+    reset();
+}
+
+void World::reseed(uint64_t seed) {
+    disappearRng.reseed(seed, static_cast<uint64_t>(RandomStream::PlatformDisappear));
+    levelRng.reseed(seed, static_cast<uint64_t>(RandomStream::Level));
+}
+
+void World::reset() {
+    platforms.clear();
+    enemies.clear();
+    projectiles.clear();
+    platformGrid.clear();
+    enemyGrid.clear();
+
+    time = 0.0f;
+    lastShotTime = -GameConstants::PROJECTILE_COOLDOWN / 1000.0f;
+    cameraY = 0.0f;
+    prevCameraY = 0.0f;
+    bonusScore = 0;
+    gameOver = false;
+
+    float startPlatformX = width / 2.0f - GameConstants::PLATFORM_WIDTH / 2.0f;
+    float startPlatformY = height - 65.0f;
+    EntityHandle start = platforms.create(startPlatformX, startPlatformY, GameConstants::PLATFORM_WIDTH, GameConstants::PLATFORM_HEIGHT);
+    platforms.value[platforms.indexOf(start)] = 1.0f;
+    platformGrid.insert(start, startPlatformY, GameConstants::PLATFORM_HEIGHT);
+
+    // A restart reuses the player object rather than allocating a new one.
+    Player fresh(
+        startPlatformX + (GameConstants::PLATFORM_WIDTH - GameConstants::PLAYER_WIDTH) / 2.0f,
+        startPlatformY - GameConstants::PLAYER_HEIGHT - 150.0f,
+        config.playerSpeed);
+    if (player) *player = fresh;
+    else player = std::make_unique<Player>(fresh);
+
+    // Every game gets a fresh level; the worker starts on it right away.
+    uint64_t levelSeed = static_cast<uint64_t>(levelRng.next()) << 32;
+    levelSeed |= levelRng.next();
+    level->restart(generator.begin(levelSeed, startPlatformX, startPlatformY));
+    chunk.count = 0;
+    chunkNext = 0;
+    spawnAhead();
+}
+
+void World::applyCommand(const InputCommand& command) {
+    if (!player || gameOver) return;
+    switch (command.type) {
+    case CommandType::MoveLeft: player->moveLeft(); break;
+    case CommandType::MoveRight: player->moveRight(); break;
+    case CommandType::ReleaseLeft: if (player->getVelocityX() < 0) player->stop(); break;
+    case CommandType::ReleaseRight: if (player->getVelocityX() > 0) player->stop(); break;
+    case CommandType::Shoot: shoot(command.targetX, command.targetY); break;
+    }
+}
+
+// Platforms and the player are integrated twice per step (once up front and
+// once in updateEntities); the jump arc and fade speed are tuned around that.
+void World::step(float deltaTime) {
+    DJ_PROFILE_ZONE("World::step");
+    if (gameOver) return;
+    time += deltaTime;
+    savePreviousPositions();
+
+    advancePlatforms(deltaTime);
+    if (player) player->update(deltaTime);
+
+    updateEntities(deltaTime);
+    if (gameOver) return;
+    handleCollisions();
+
+    platforms.removeIf([this](size_t i) { return despawnPlatform(i, !platforms.isActive(i)); });
+    spawnAhead();
+}
+
+bool World::despawnPlatform(size_t index, bool despawn) {
+    if (despawn) platformGrid.remove(platforms.handleAt(index), platforms.y[index]);
+    return despawn;
+}
+
+bool World::despawnEnemy(size_t index, bool despawn) {
+    if (despawn) enemyGrid.remove(enemies.handleAt(index), enemies.y[index]);
+    return despawn;
+}
+
+namespace {
+    struct StateHasher {
+        uint64_t hash = 1469598103934665603ull;
+
+        void bytes(const void* data, size_t size) {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+        template <typename T>
+        void value(const T& v) { bytes(&v, sizeof(v)); }
+        template <typename T>
+        void values(const std::vector<T>& v) { value(v.size()); if (!v.empty()) bytes(v.data(), v.size() * sizeof(T)); }
+    };
+}
+
+uint64_t World::computeStateHash() const {
+    StateHasher h;
+    h.value(time);
+    h.value(lastShotTime);
+    h.value(cameraY);
+    h.value(bonusScore);
+    h.value(gameOver);
+    h.value(chunk.index);
+    h.value(chunkNext);
+    if (player) {
+        h.value(player->getX());
+        h.value(player->getY());
+        h.value(player->getVelocityX());
+        h.value(player->getVelocityY());
+        h.value(player->getPlatformsCount());
+        h.value(player->getJetpackTime());
+    }
+    for (const EntityStore* store : { &platforms, &enemies, &projectiles }) {
+        h.values(store->x);
+        h.values(store->y);
+        h.values(store->velocityX);
+        h.values(store->velocityY);
+        h.values(store->value);
+        h.values(store->variant);
+        h.values(store->flags);
+    }
+    return h.hash;
+}
+
+bool World::cooldown() const {
+    float elapsedMs = (time - lastShotTime) * 1000.0f;
+    return elapsedMs < GameConstants::PROJECTILE_COOLDOWN;
+}
+
+void World::savePreviousPositions() {
+    prevCameraY = cameraY;
+    if (player) player->savePreviousPosition();
+    platforms.savePreviousPositions();
+    enemies.savePreviousPositions();
+    projectiles.savePreviousPositions();
+}
+
+void World::advancePlatforms(float deltaTime) {
+    DJ_PROFILE_ZONE("advancePlatforms");
+    float fade = GameConstants::PLATFORM_FADE_SPEED * deltaTime;
+    size_t count = platforms.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (platforms.hasFlag(i, ENTITY_DISAPPEARING)) {
+            platforms.value[i] -= fade;
+            if (platforms.value[i] <= 0) platforms.setFlag(i, ENTITY_ACTIVE, false);
+        }
+    }
+}
+
+// Platforms come out of the level's chunks in order, each once it is within
+// LEVEL_SPAWN_AHEAD of the view. A full pool leaves the rest for a later step.
+void World::spawnAhead() {
+    float horizon = cameraY - GameConstants::LEVEL_SPAWN_AHEAD;
+    for (;;) {
+        if (chunkNext == chunk.count) {
+            level->next(chunk);
+            chunkNext = 0;
+        }
+        const ChunkPlatform& next = chunk.platforms[chunkNext];
+        if (next.y < horizon || !spawnPlatform(next)) return;
+        ++chunkNext;
+    }
+}
+
+bool World::spawnPlatform(const ChunkPlatform& spawn) {
+    EntityHandle platform = platforms.create(spawn.x, spawn.y, GameConstants::PLATFORM_WIDTH, GameConstants::PLATFORM_HEIGHT);
+    if (!platform.isValid()) return false;
+    size_t index = platforms.indexOf(platform);
+    platforms.value[index] = 1.0f;
+    platformGrid.insert(platform, spawn.y, GameConstants::PLATFORM_HEIGHT);
+    if (spawn.flags & CHUNK_JETPACK) platforms.setFlag(index, ENTITY_HAS_JETPACK);
+    if (spawn.enemyType >= 0) spawnEnemyOn(index, spawn.enemyType);
+    return true;
+}
+
+void World::spawnEnemyOn(size_t platformIndex, int enemyType) {
+    float enemyWidth = static_cast<float>(GameConstants::ENEMY_TYPE_WIDTH[enemyType]);
+    float enemyHeight = static_cast<float>(GameConstants::ENEMY_TYPE_HEIGHT[enemyType]);
+    float enemyX = platforms.x[platformIndex] + (GameConstants::PLATFORM_WIDTH - enemyWidth) / 2;
+    float enemyY = platforms.y[platformIndex] - enemyHeight;
+
+    EntityHandle enemy = enemies.create(enemyX, enemyY, enemyWidth, enemyHeight);
+    if (!enemy.isValid()) return;
+    platforms.setFlag(platformIndex, ENTITY_HAS_ENEMY);
+    enemies.variant[enemies.indexOf(enemy)] = static_cast<uint8_t>(enemyType);
+    enemyGrid.insert(enemy, enemyY, enemyHeight);
+}
+
+void World::updateEntities(float deltaTime) {
+    DJ_PROFILE_ZONE("updateEntities");
+    if (!player) return;
+    updatePlayer(deltaTime);
+    if (gameOver) return;
+    updatePlatforms(deltaTime);
+    updateProjectiles(deltaTime);
+    updateEnemies();
+}
+
+void World::updatePlayer(float deltaTime) {
+    player->update(deltaTime);
+    player->setLookingUp(cooldown());
+
+    if (player->getX() < 0) player->setPosition(0, player->getY());
+    if (player->getX() > width - GameConstants::PLAYER_WIDTH) player->setPosition(static_cast<float>(width - GameConstants::PLAYER_WIDTH), player->getY());
+
+    if (player->getY() > cameraY + height) { gameOver = true; return; }
+
+    // The camera only ever moves up, keeping the player at or below mid-screen.
+    if (player->getY() < cameraY + height / 2.0f) cameraY = player->getY() - height / 2.0f;
+}
+
+void World::updatePlatforms(float deltaTime) {
+    DJ_PROFILE_ZONE("updatePlatforms");
+    advancePlatforms(deltaTime);
+
+    float bottom = cameraY + height;
+    platforms.removeIf([this, bottom](size_t i) { return despawnPlatform(i, platforms.y[i] > bottom || !platforms.isActive(i)); });
+}
+
+void World::handleCollisions() {
+    DJ_PROFILE_ZONE("handleCollisions");
+    if (!player) return;
+
+    float playerBottom = player->getY() + GameConstants::PLAYER_HEIGHT;
+    float previousBottom = player->getPreviousY() + GameConstants::PLAYER_HEIGHT;
+    float playerLeft = player->getX();
+    float playerRight = player->getX() + GameConstants::PLAYER_WIDTH;
+
+    // Only platforms whose top lies between where the feet were at the start
+    // of the step (less the landing window) and where they are now can be
+    // landed on. The sweep means a low tick rate can't carry the player
+    // through the 10px window. Of several candidates the earliest spawned wins.
+    if (player->getVelocityY() > 0) {
+        size_t landed = platforms.size();
+        platformGrid.forEachTopInRange(previousBottom - 10.0f, playerBottom, [&](EntityHandle handle) {
+            size_t i = platforms.indexOf(handle);
+            if (i < landed && playerRight >= platforms.x[i] && playerLeft <= platforms.x[i] + platforms.width[i]) landed = i;
+        });
+
+        if (landed < platforms.size()) {
+            player->setPosition(player->getX(), platforms.y[landed] - GameConstants::PLAYER_HEIGHT);
+            player->setVelocityY(0);
+            player->jump();
+            EntityHandle platform = platforms.handleAt(landed);
+            if (platform != player->getLastJumpedPlatform()) { player->updatePlatformCount(); player->setLastJumpedPlatform(platform); }
+            // A platform rolls for fading the first time it is used, so the
+            // route ahead is never gone before the player gets there.
+            if (!platforms.hasFlag(landed, ENTITY_CHECKED_FOR_DISAPPEARING | ENTITY_HAS_ENEMY)) {
+                platforms.setFlag(landed, ENTITY_CHECKED_FOR_DISAPPEARING);
+                if (disappearRng.chance(config.platformDisappearingChance)) platforms.setFlag(landed, ENTITY_DISAPPEARING);
+            }
+            if (platforms.hasFlag(landed, ENTITY_HAS_JETPACK)) {
+                platforms.setFlag(landed, ENTITY_HAS_JETPACK, false);
+                player->startJetpack();
+            }
+        }
+    }
+
+    bool hit = false;
+    float playerX = player->getX();
+    float playerY = player->getY();
+    enemyGrid.forEachOverlapping(playerY, playerY + GameConstants::PLAYER_HEIGHT, [&](EntityHandle handle) {
+        size_t i = enemies.indexOf(handle);
+        if (enemies.isActive(i) &&
+            overlaps(playerX, playerY, GameConstants::PLAYER_WIDTH, GameConstants::PLAYER_HEIGHT,
+                enemies.x[i], enemies.y[i], enemies.width[i], enemies.height[i])) hit = true;
+    });
+    if (hit) gameOver = true;
+}
+
+void World::shoot(float targetX, float targetY) {
+    if (cooldown()) return;
+    player->setLookingUp(false);
+
+    float playerCenterX = player->getX() + GameConstants::PLAYER_WIDTH / 2;
+    float playerCenterY = player->getY() + GameConstants::PLAYER_HEIGHT / 2;
+
+    float dx = targetX - playerCenterX;
+    float dy = targetY - playerCenterY;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    EntityHandle projectile = projectiles.create(playerCenterX, playerCenterY, GameConstants::PROJECTILE_WIDTH, GameConstants::PROJECTILE_HEIGHT);
+    if (!projectile.isValid()) return;
+
+    float angle = std::atan2(dx, -dy) * 180.0f / 3.14159f;
+    angle = std::max(-90.0f, std::min(90.0f, angle));
+
+    player->setNoseAngle(angle);
+
+    float dirX = dx / length;
+    float dirY = dy / length;
+
+    size_t index = projectiles.indexOf(projectile);
+    projectiles.value[index] = std::atan2(dirY, dirX);
+    projectiles.velocityX[index] = dirX * GameConstants::PROJECTILE_SPEED;
+    projectiles.velocityY[index] = dirY * GameConstants::PROJECTILE_SPEED;
+    lastShotTime = time;
+}
+
+void World::updateProjectiles(float deltaTime) {
+    projectiles.integrate(deltaTime);
+
+    float top = cameraY;
+    float bottom = cameraY + height;
+    float right = static_cast<float>(width);
+    projectiles.removeIf([this, top, bottom, right](size_t i) {
+        return !projectiles.isActive(i) || projectiles.x[i] < 0 || projectiles.x[i] > right || projectiles.y[i] < top || projectiles.y[i] > bottom;
+    });
+}
+
+void World::updateEnemies() {
+    float bottom = cameraY + height;
+    enemies.removeIf([this, bottom](size_t i) { return despawnEnemy(i, !enemies.isActive(i) || enemies.y[i] > bottom); });
+
+    size_t projectileCount = projectiles.size();
+    for (size_t p = 0; p < projectileCount; ++p) {
+        float projectileX = projectiles.x[p];
+        float projectileY = projectiles.y[p];
+        enemyGrid.forEachOverlapping(projectileY, projectileY + projectiles.height[p], [&](EntityHandle handle) {
+            size_t e = enemies.indexOf(handle);
+            if (enemies.isActive(e) && projectiles.isActive(p) &&
+                overlaps(enemies.x[e], enemies.y[e], enemies.width[e], enemies.height[e],
+                    projectileX, projectileY, projectiles.width[p], projectiles.height[p])) {
+                enemies.setFlag(e, ENTITY_ACTIVE, false);
+                projectiles.setFlag(p, ENTITY_ACTIVE, false);
+                bonusScore += 100;
+            }
+        });
+    }
+}
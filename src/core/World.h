@@ -0,0 +1,100 @@
+#pragma once
+#include "Entity.h"
+#include "EntityStore.h"
+#include "YBucketGrid.h"
+#include "GameConfig.h"
+#include "LevelGenerator.h"
+#include "Random.h"
+#include <memory>
+
+// Commands a client feeds into the simulation. Shoot targets are given in
+// world coordinates.
+enum class CommandType {
+    MoveLeft,
+    MoveRight,
+    ReleaseLeft,
+    ReleaseRight,
+    Shoot
+};
+
+struct InputCommand {
+    CommandType type;
+    float targetX = 0.0f;
+    float targetY = 0.0f;
+};
+
+// The gameplay rules without any windowing or rendering: feed it commands and
+// a timestep, read entity state back out. Entity coordinates are world space
+// and never move once spawned; the camera tracks the top of the view (world y
+// decreases as the player climbs) and clients subtract it when drawing.
+class World {
+private:
+    GameConfig config;
+    int width, height;
+    std::unique_ptr<Player> player;
+    EntityStore platforms;   // value: opacity
+    EntityStore enemies;     // variant: enemy type
+    EntityStore projectiles; // value: flight angle
+    YBucketGrid platformGrid;
+    YBucketGrid enemyGrid;
+    float time;
+    float lastShotTime;
+    float cameraY;
+    float prevCameraY;
+    int bonusScore;
+    bool gameOver;
+    Pcg32 disappearRng;
+    Pcg32 levelRng;
+    LevelGenerator generator;
+    std::unique_ptr<LevelStreamer> level;
+    LevelChunk chunk;   // the chunk being spawned from
+    int chunkNext;      // its next platform to spawn
+
+public:
+    World(const GameConfig& cfg, int worldWidth, int worldHeight);
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    void reset();
+    // Restarts every random stream from seed. The constructor seeds from the
+    // config; reset() keeps the streams going so consecutive games differ.
+    void reseed(uint64_t seed);
+    void applyCommand(const InputCommand& command);
+    void step(float deltaTime);
+
+    const Player* getPlayer() const { return player.get(); }
+    const EntityStore& getPlatforms() const { return platforms; }
+    const EntityStore& getEnemies() const { return enemies; }
+    const EntityStore& getProjectiles() const { return projectiles; }
+    const PoolStats& getPlatformPoolStats() const { return platforms.getStats(); }
+    const PoolStats& getEnemyPoolStats() const { return enemies.getStats(); }
+    const PoolStats& getProjectilePoolStats() const { return projectiles.getStats(); }
+    const LevelStreamStats& getLevelStats() const { return level->getStats(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    float getCameraY() const { return cameraY; }
+    float getPreviousCameraY() const { return prevCameraY; }
+    float getInterpolatedCameraY(float alpha) const { return prevCameraY + (cameraY - prevCameraY) * alpha; }
+    int getScore() const { return static_cast<int>(-cameraY * 0.5f) + bonusScore; }
+    bool isGameOver() const { return gameOver; }
+    float getTime() const { return time; }
+    bool cooldown() const;
+    // FNV-1a over everything that shapes future steps; replays compare it.
+    uint64_t computeStateHash() const;
+
+private:
+    void savePreviousPositions();
+    void advancePlatforms(float deltaTime);
+    void updateEntities(float deltaTime);
+    void updatePlayer(float deltaTime);
+    void updatePlatforms(float deltaTime);
+    void updateProjectiles(float deltaTime);
+    void updateEnemies();
+    void spawnAhead();
+    bool spawnPlatform(const ChunkPlatform& spawn);
+    void spawnEnemyOn(size_t platformIndex, int enemyType);
+    void shoot(float targetX, float targetY);
+    void handleCollisions();
+    bool despawnPlatform(size_t index, bool despawn);
+    bool despawnEnemy(size_t index, bool despawn);
+};
@@ -0,0 +1,36 @@
+#include "YBucketGrid.h"
+
+YBucketGrid::YBucketGrid(float rowHeight, size_t bucketCount)
+    : buckets(bucketCount > 0 ? bucketCount : 1)
+    , bucketHeight(rowHeight > 0.0f ? rowHeight : 1.0f)
+    , maxEntityHeight(0.0f)
+    , entryCount(0)
+{}
+
+void YBucketGrid::insert(EntityHandle handle, float top, float height) {
+    bucketFor(rowOf(top)).push_back({ handle, top });
+    if (height > maxEntityHeight) maxEntityHeight = height;
+    ++entryCount;
+}
+
+void YBucketGrid::remove(EntityHandle handle, float top) {
+    std::vector<Entry>& bucket = bucketFor(rowOf(top));
+    for (size_t i = 0; i < bucket.size(); ++i) {
+        if (bucket[i].handle == handle) {
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            --entryCount;
+            return;
+        }
+    }
+}
+
+void YBucketGrid::clear() {
+    for (auto& bucket : buckets) bucket.clear();
+    maxEntityHeight = 0.0f;
+    entryCount = 0;
+}
+
+void YBucketGrid::reserve(size_t entriesPerBucket) {
+    for (auto& bucket : buckets) bucket.reserve(entriesPerBucket);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "EntityStore.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Broadphase for a vertical scroller. Entities are bucketed by the world y of
+// their top edge into fixed-height rows; rows map onto a ring of buckets, so
+// the grid never needs rebuilding as the camera climbs as long as the ring
+// covers the band of live entities. Entries keep their exact top so aliased
+// rows are filtered out before the caller's narrowphase runs.
+class YBucketGrid {
+private:
+    struct Entry {
+        EntityHandle handle;
+        float top;
+    };
+
+    std::vector<std::vector<Entry>> buckets;
+    float bucketHeight;
+    float maxEntityHeight;
+    size_t entryCount;
+
+    int64_t rowOf(float y) const { return static_cast<int64_t>(std::floor(y / bucketHeight)); }
+    std::vector<Entry>& bucketFor(int64_t row) { return buckets[wrap(row)]; }
+    const std::vector<Entry>& bucketFor(int64_t row) const { return buckets[wrap(row)]; }
+    size_t wrap(int64_t row) const {
+        int64_t count = static_cast<int64_t>(buckets.size());
+        int64_t index = row % count;
+        return static_cast<size_t>(index < 0 ? index + count : index);
+    }
+
+public:
+    YBucketGrid(float rowHeight, size_t bucketCount);
+
+    void insert(EntityHandle handle, float top, float height);
+    void remove(EntityHandle handle, float top);
+    void clear();
+    void reserve(size_t entriesPerBucket);
+    size_t size() const { return entryCount; }
+
+    // Calls fn(handle) for every entity whose top lies in [minTop, maxTop].
+    template <typename Fn>
+    void forEachTopInRange(float minTop, float maxTop, Fn fn) const {
+        int64_t first = rowOf(minTop);
+        int64_t last = rowOf(maxTop);
+        if (last - first + 1 >= static_cast<int64_t>(buckets.size())) last = first + static_cast<int64_t>(buckets.size()) - 1;
+        for (int64_t row = first; row <= last; ++row) {
+            for (const Entry& entry : bucketFor(row)) {
+                if (entry.top >= minTop && entry.top <= maxTop) fn(entry.handle);
+            }
+        }
+    }
+
+    // Calls fn(handle) for every entity that may vertically overlap [top, bottom].
+    template <typename Fn>
+    void forEachOverlapping(float top, float bottom, Fn fn) const {
+        forEachTopInRange(top - maxEntityHeight, bottom, fn);
+    }
+};
@@ -1,12 +1,22 @@
 #define FRAMEWORK_PROJECT
 #include "framework.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include <gdiplus.h>
 #include <chrono>
 #include <stdexcept>
 
+#pragma comment(lib, "gdiplus.lib")
+
+// Win32 window layer: the framebuffer is a top-down 32bpp DIB section, so
+// presenting a frame is a BitBlt per dirty rectangle of memory the software
+// renderer already wrote.
+
 namespace {
     HWND hWnd = nullptr;
     HDC hDC = nullptr;   
     HBITMAP hBackBuffer = nullptr;
+    HGDIOBJ hPreviousBitmap = nullptr;
     HDC hBackDC = nullptr;
     int screenWidth = 800;
     int screenHeight = 600;
@@ -16,8 +26,8 @@ namespace {
     ULONG_PTR gdiplusToken;
     int lastMouseX = 0;
     int lastMouseY = 0;
-    Sprite* backgroundSprite = nullptr;
-    Sprite* scoreSprite = nullptr;
+    int frameRateLimit = 60;
+    FramePacingStats pacingStats;
 
     // Conversion char* into wchar_t*
     std::wstring convertToWideString(const char* str) {
@@ -32,6 +42,16 @@ namespace {
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
     case WM_CLOSE: PostQuitMessage(0); return 0;
+    // Frames only present what changed, so exposed areas are repainted from
+    // the back buffer, which always holds the whole last frame.
+    case WM_PAINT: {
+        PAINTSTRUCT ps;
+        HDC paintDC = BeginPaint(hwnd, &ps);
+        if (hBackDC) BitBlt(paintDC, ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+            hBackDC, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
+        EndPaint(hwnd, &ps);
+        return 0;
+    }
     case WM_MOUSEMOVE:
         if (currentFramework) {
             int x = LOWORD(lParam);
@@ -109,8 +129,18 @@ bool initWindow(const char* title, bool fullscreen) {
     
     hDC = GetDC(hWnd);
     hBackDC = CreateCompatibleDC(hDC);
-    hBackBuffer = CreateCompatibleBitmap(hDC, screenWidth, screenHeight);
-    SelectObject(hBackDC, hBackBuffer);
+
+    BITMAPINFO info = { 0 };
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = screenWidth;
+    info.bmiHeader.biHeight = -screenHeight;
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+    void* pixels = nullptr;
+    hBackBuffer = CreateDIBSection(hDC, &info, DIB_RGB_COLORS, &pixels, NULL, 0);
+    if (!hBackBuffer || !createFramebuffer(screenWidth, screenHeight, static_cast<uint32_t*>(pixels))) return false;
+    hPreviousBitmap = SelectObject(hBackDC, hBackBuffer);
     ShowWindow(hWnd, SW_SHOW);
     UpdateWindow(hWnd);
 
@@ -121,95 +151,6 @@ bool initWindow(const char* title, bool fullscreen) {
 extern "C" {
 #endif
     FRAMEWORK_API HDC getHDC() { return hDC; }
-    FRAMEWORK_API Sprite* getGameScoreSprite() { return scoreSprite; }
-
-    FRAMEWORK_API void setBackgroundSprite(const char* path) { backgroundSprite = createSprite(path); }
-
-    FRAMEWORK_API void setScoreSprite(const char* path) { scoreSprite = createSprite(path); }
-
-    FRAMEWORK_API Sprite* createSprite(const char* path) {
-        if (!path) return nullptr;
-
-        std::wstring widePath = convertToWideString(path);
-        Gdiplus::Bitmap* bitmap = nullptr;
-
-        try {
-            bitmap = new Gdiplus::Bitmap(widePath.c_str());
-            if (!bitmap || bitmap->GetLastStatus() != Gdiplus::Ok) { delete bitmap; return nullptr; }
-            return new Sprite(bitmap);
-        }
-        catch (const std::exception& e) {
-#ifdef _DEBUG
-            printf("Exception while loading sprite: %s - %s\n", path, e.what());
-#endif
-            delete bitmap;
-            return nullptr;
-        }
-    }
-
-    FRAMEWORK_API void drawSprite(Sprite* sprite, int x, int y) {
-        if (!sprite || !sprite->getBitmap()) return;
-        Gdiplus::Graphics graphics(hBackDC);
-        graphics.DrawImage(
-            sprite->getBitmap(),
-            x, y,
-            sprite->getWidth(),
-            sprite->getHeight()
-        );
-    }
-
-    FRAMEWORK_API void drawSpriteRotated(Sprite* sprite, int x, int y, float angle) {
-        if (!sprite || !sprite->getBitmap()) return;
-
-        Gdiplus::Graphics graphics(hBackDC);
-
-        Gdiplus::Matrix originalMatrix;
-        graphics.GetTransform(&originalMatrix);
-
-        Gdiplus::Matrix rotationMatrix;
-        rotationMatrix.RotateAt(
-            angle,
-            Gdiplus::PointF(
-                static_cast<float>(x + sprite->getWidth() / 2),
-                static_cast<float>(y + sprite->getHeight() / 2)
-            )
-        );
-
-        graphics.SetTransform(&rotationMatrix);
-
-        graphics.DrawImage(
-            sprite->getBitmap(),
-            x, y,
-            sprite->getWidth(),
-            sprite->getHeight()
-        );
-        graphics.SetTransform(&originalMatrix);
-    }
-
-    FRAMEWORK_API void getSpriteSize(Sprite* sprite, int& width, int& height) {
-        if (!sprite) return; width = sprite->getWidth(); height = sprite->getHeight();
-        }
-
-    FRAMEWORK_API void setSpriteSize(Sprite* sprite, int width, int height) {
-        if (!sprite) return; sprite->setSize(width, height);
-    }
-
-    FRAMEWORK_API void destroySprite(Sprite* sprite) { delete sprite; }
-
-    FRAMEWORK_API void drawTestBackground() {
-        if (backgroundSprite && scoreSprite) {
-            drawSprite(backgroundSprite, 0, 0);
-            drawSprite(scoreSprite, 0, 0);
-        }
-        else {
-            RECT rect = { 0, 0, screenWidth, screenHeight };
-            FillRect(hBackDC, &rect, (HBRUSH)GetStockObject(GRAY_BRUSH));
-        }
-    }
-
-    FRAMEWORK_API void getScreenSize(int& width, int& height) {
-        width = screenWidth; height = screenHeight;
-    }
 
     FRAMEWORK_API unsigned int getTickCount() {
         auto now = std::chrono::steady_clock::now();
@@ -220,8 +161,13 @@ extern "C" {
 
     FRAMEWORK_API void showCursor(bool show) { ::ShowCursor(show); }
 
+    FRAMEWORK_API void setFrameRateLimit(int fps) { frameRateLimit = fps > 0 ? fps : 0; }
+
+    FRAMEWORK_API void getFramePacingStats(FramePacingStats& stats) { stats = pacingStats; }
+
     FRAMEWORK_API int run(Framework* framework) {
         if (!framework) return -1;
+        // GDI+ is only used to decode images.
         Gdiplus::GdiplusStartup(&gdiplusToken, &gdiplusStartupInput, NULL);
         currentFramework = framework;
 
@@ -235,11 +181,15 @@ extern "C" {
         startTime = std::chrono::steady_clock::now();
         if (!framework->Init()) return -1;
 
-        setBackgroundSprite("material/backdrop.jpg");
-        setScoreSprite("material/score.png");
+        // Games that bring their own layers set them during Init.
+        if (!hasBackgroundLayers()) {
+            setBackgroundSprite("material/backdrop.jpg");
+            setScoreSprite("material/score.png");
+        }
 
         MSG msg;
         bool running = true;
+        FramePacer pacer(frameRateLimit);
 
         while (running) {
             while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
@@ -249,16 +199,33 @@ extern "C" {
             }
 
             if (running) {
-                drawTestBackground();
-                if (framework->Tick()) running = false;
-                BitBlt(hDC, 0, 0, screenWidth, screenHeight,
-                    hBackDC, 0, 0, SRCCOPY);
+                beginFrame();
+                {
+                    DJ_PROFILE_ZONE("Tick");
+                    if (framework->Tick()) running = false;
+                }
+                int dirtyCount = 0;
+                const ClipRect* dirty = endFrame(dirtyCount);
+                {
+                    DJ_PROFILE_ZONE("BitBlt");
+                    GdiFlush();
+                    for (int i = 0; i < dirtyCount; ++i) {
+                        const ClipRect& r = dirty[i];
+                        BitBlt(hDC, r.left, r.top, r.right - r.left, r.bottom - r.top, hBackDC, r.left, r.top, SRCCOPY);
+                    }
+                }
+                framework->onFramePresented();
+                pacer.wait();
+                DJ_PROFILE_FRAME();
             }
         }
 
+        pacingStats = pacer.getStats();
         framework->Close();
         currentFramework = nullptr;
 
+        destroyFramebuffer();
+        SelectObject(hBackDC, hPreviousBitmap);
         DeleteDC(hBackDC);
         DeleteObject(hBackBuffer);
         ReleaseDC(hWnd, hDC);
@@ -270,4 +237,4 @@ extern "C" {
 
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,167 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    int compareName(const archive::Entry& entry, const char* name) {
+        return strncmp(entry.name, name, archive::NAME_SIZE);
+    }
+
+    size_t alignUp(size_t value) { return (value + archive::ALIGNMENT - 1) & ~(archive::ALIGNMENT - 1); }
+}
+
+uint32_t archive::checksum(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+bool writeAssetArchive(const char* path, std::vector<PackedImage>& images) {
+    std::sort(images.begin(), images.end(), [](const PackedImage& a, const PackedImage& b) { return a.name < b.name; });
+
+    std::vector<archive::Entry> entries(images.size());
+    size_t offset = alignUp(sizeof(archive::Header) + entries.size() * sizeof(archive::Entry));
+    for (size_t i = 0; i < images.size(); ++i) {
+        const PackedImage& image = images[i];
+        if (image.name.size() >= archive::NAME_SIZE) return false;
+        archive::Entry& entry = entries[i];
+        memset(&entry, 0, sizeof(entry));
+        memcpy(entry.name, image.name.c_str(), image.name.size());
+        entry.width = static_cast<uint32_t>(image.width);
+        entry.height = static_cast<uint32_t>(image.height);
+        entry.flags = image.opaque ? archive::FLAG_OPAQUE : 0;
+        entry.checksum = archive::checksum(image.pixels.data(), image.pixels.size() * sizeof(uint32_t));
+        entry.offset = offset;
+        offset = alignUp(offset + image.pixels.size() * sizeof(uint32_t));
+    }
+
+    archive::Header header = {};
+    memcpy(header.magic, archive::MAGIC, sizeof(header.magic));
+    header.version = archive::VERSION;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.fileSize = offset;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    std::vector<uint8_t> padding(archive::ALIGNMENT, 0);
+    size_t written = 0;
+    auto put = [&](const void* bytes, size_t count) {
+        if (count && fwrite(bytes, 1, count, file) != count) return false;
+        written += count;
+        return true;
+    };
+    bool ok = put(&header, sizeof(header)) && put(entries.data(), entries.size() * sizeof(archive::Entry));
+    for (size_t i = 0; ok && i < images.size(); ++i) {
+        ok = put(padding.data(), entries[i].offset - written)
+            && put(images[i].pixels.data(), images[i].pixels.size() * sizeof(uint32_t));
+    }
+    ok = ok && put(padding.data(), offset - written);
+    return fclose(file) == 0 && ok;
+}
+
+bool AssetArchive::open(const char* path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+        ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    void* view = fstat(fd, &info) == 0 && info.st_size > 0
+        ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    // Everything the index claims must lie inside the file; a truncated or
+    // foreign file is rejected as a whole.
+    const archive::Header* header = reinterpret_cast<const archive::Header*>(data);
+    bool valid = size >= sizeof(archive::Header)
+        && memcmp(header->magic, archive::MAGIC, sizeof(header->magic)) == 0
+        && header->version == archive::VERSION
+        && header->fileSize == size
+        && header->entryCount <= (size - sizeof(archive::Header)) / sizeof(archive::Entry);
+    if (valid) {
+        entries = reinterpret_cast<const archive::Entry*>(data + sizeof(archive::Header));
+        entryCount = header->entryCount;
+        for (size_t i = 0; valid && i < entryCount; ++i) {
+            const archive::Entry& e = entries[i];
+            uint64_t bytes = static_cast<uint64_t>(e.width) * e.height * sizeof(uint32_t);
+            valid = e.name[archive::NAME_SIZE - 1] == '\0' && e.width > 0 && e.height > 0
+                && e.width <= 0x7FFF && e.height <= 0x7FFF
+                && e.offset % archive::ALIGNMENT == 0 && e.offset <= size && bytes <= size - e.offset
+                && (i == 0 || compareName(entries[i - 1], e.name) < 0);
+        }
+    }
+    if (!valid) { close(); return false; }
+    verified = std::make_unique<std::atomic<uint8_t>[]>(entryCount);
+    for (size_t i = 0; i < entryCount; ++i) verified[i].store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void AssetArchive::close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    entries = nullptr;
+    entryCount = 0;
+    verified.reset();
+}
+
+bool AssetArchive::find(const char* name, Surface& surface, bool& opaque) {
+    if (!data || !name) return false;
+    const archive::Entry* end = entries + entryCount;
+    const archive::Entry* it = std::lower_bound(entries, end, name,
+        [](const archive::Entry& entry, const char* key) { return compareName(entry, key) < 0; });
+    if (it == end || compareName(*it, name) != 0) return false;
+
+    size_t index = static_cast<size_t>(it - entries);
+    const uint8_t* pixels = data + it->offset;
+    size_t bytes = static_cast<size_t>(it->width) * it->height * sizeof(uint32_t);
+    uint8_t state = verified[index].load(std::memory_order_acquire);
+    if (state == 0) {
+        state = archive::checksum(pixels, bytes) == it->checksum ? 1 : 2;
+        verified[index].store(state, std::memory_order_release);
+    }
+    if (state != 1) return false;
+
+    // Sprites never write to their pixels; the mapping itself is read-only.
+    surface = { reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(pixels)), static_cast<int>(it->width), static_cast<int>(it->height), static_cast<int>(it->width) };
+    opaque = (it->flags & archive::FLAG_OPAQUE) != 0;
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Surface.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A pack of pre-decoded sprites, written by DoodlePack and memory-mapped at
+// runtime. Pixels are stored premultiplied in the back buffer's format, so a
+// lookup hands out a Surface that points straight into the mapping.
+//
+// Layout, little endian: a fixed header, entryCount index entries sorted by
+// name, then each entry's pixels, tightly packed and 64-byte aligned.
+namespace archive {
+    constexpr char MAGIC[4] = { 'D', 'J', 'P', 'K' };
+    constexpr uint32_t VERSION = 1;
+    constexpr size_t NAME_SIZE = 48;
+    constexpr size_t ALIGNMENT = 64;
+    constexpr uint32_t FLAG_OPAQUE = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t fileSize;
+    };
+
+    struct Entry {
+        char name[NAME_SIZE];   // path as the game asks for it, NUL padded
+        uint32_t width;
+        uint32_t height;
+        uint32_t flags;
+        uint32_t checksum;      // FNV-1a over the pixel bytes
+        uint64_t offset;
+    };
+
+    static_assert(sizeof(Header) == 24, "archive header layout");
+    static_assert(sizeof(Entry) == 72, "archive entry layout");
+
+    uint32_t checksum(const void* data, size_t size);
+}
+
+struct PackedImage {
+    std::string name;
+    int width = 0;
+    int height = 0;
+    bool opaque = true;
+    std::vector<uint32_t> pixels;
+};
+
+// Writes images (any order) as an archive; false on an I/O error or a name
+// that doesn't fit.
+bool writeAssetArchive(const char* path, std::vector<PackedImage>& images);
+
+class AssetArchive {
+public:
+    AssetArchive() = default;
+    ~AssetArchive() { close(); }
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // Maps the file and validates the header and index. Pixel checksums are
+    // checked per entry on first lookup, so untouched entries stay on disk.
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    size_t getEntryCount() const { return entryCount; }
+
+    // False if the entry is missing or its pixels don't match the checksum.
+    // Safe to call from several threads at once.
+    bool find(const char* name, Surface& surface, bool& opaque);
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const archive::Entry* entries = nullptr;
+    size_t entryCount = 0;
+    // Per entry: 0 unchecked, 1 valid, 2 corrupt.
+    std::unique_ptr<std::atomic<uint8_t>[]> verified;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
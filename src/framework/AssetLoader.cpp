@@ -0,0 +1,105 @@
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+AssetLoader::AssetLoader(size_t threadCount) : pool(std::make_unique<ThreadPool>(threadCount)) {}
+
+// The pool is declared first and would be destroyed last, so it is joined
+// here, before the members its drain() tasks read.
+AssetLoader::~AssetLoader() { pool.reset(); }
+
+void AssetLoader::start(const AssetRequest* requests, size_t count) {
+    // A drain() task still reads nextSlot and slots after the last decode, so
+    // wait for the tasks themselves rather than for pending.
+    pool->wait();
+    startTime = std::chrono::steady_clock::now();
+    slots.clear();
+    slots.reserve(count);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < count; ++i) {
+            if (requests[i].critical != (pass == 0)) continue;
+            slots.emplace_back();
+            slots.back().path = requests[i].path;
+            slots.back().critical = requests[i].critical;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats = AssetLoadStats();
+        stats.assets = slots.size();
+        stats.threads = pool->getThreadCount();
+        pending = slots.size();
+        criticalPending = 0;
+        for (const Slot& slot : slots) criticalPending += slot.critical;
+    }
+    unpublished = slots.size();
+    // Workers claim slots in manifest order, so critical entries go first
+    // whatever order the pool runs its tasks in.
+    nextSlot.store(0, std::memory_order_relaxed);
+    size_t workers = std::min(pool->getThreadCount(), slots.size());
+    for (size_t i = 0; i < workers; ++i) pool->submit([this] { drain(); });
+}
+
+void AssetLoader::drain() {
+    for (size_t i = nextSlot.fetch_add(1, std::memory_order_relaxed); i < slots.size(); i = nextSlot.fetch_add(1, std::memory_order_relaxed))
+        decode(i);
+}
+
+void AssetLoader::decode(size_t index) {
+    DJ_PROFILE_ZONE("AssetLoader::decode");
+    auto begin = std::chrono::steady_clock::now();
+    Slot& slot = slots[index];
+    std::unique_ptr<Sprite> sprite(createSprite(slot.path.c_str()));
+    double ms = millisecondsSince(begin);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.decodeMs += ms;
+    if (sprite) stats.bytes += static_cast<size_t>(sprite->getSurface().width) * sprite->getSurface().height * sizeof(uint32_t);
+    else ++stats.failed;
+    slot.sprite = std::move(sprite);
+    slot.done = true;
+    if (slot.critical && --criticalPending == 0) stats.criticalMs = millisecondsSince(startTime);
+    if (--pending == 0) stats.totalMs = millisecondsSince(startTime);
+    finished.notify_all();
+}
+
+void AssetLoader::waitForCritical() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return criticalPending == 0; });
+}
+
+void AssetLoader::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0; });
+}
+
+size_t AssetLoader::publish(ResourceManager& resources) {
+    size_t added = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Slot& slot : slots) {
+        if (!slot.done || slot.published) continue;
+        resources.addSprite(slot.path.c_str(), SpriteHandle(std::move(slot.sprite)));
+        slot.published = true;
+        --unpublished;
+        ++added;
+    }
+    return added;
+}
+
+bool AssetLoader::isComplete() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return unpublished == 0;
+}
+
+AssetLoadStats AssetLoader::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "ResourceManager.h"
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+struct AssetRequest {
+    const char* path;
+    bool critical;  // needed before the first frame can be drawn
+};
+
+struct AssetLoadStats {
+    size_t assets = 0;
+    size_t failed = 0;
+    size_t bytes = 0;
+    size_t threads = 0;
+    double criticalMs = 0.0;    // start until every critical asset was decoded
+    double totalMs = 0.0;       // start until the last asset was decoded
+    double decodeMs = 0.0;      // decode time summed over all workers
+};
+
+// Decodes a manifest of sprites on worker threads. Critical entries are
+// queued first; the caller blocks only on those and picks up the rest as
+// they finish. Decoded sprites reach the ResourceManager through publish(),
+// on the thread that owns the cache, so the cache itself stays single-threaded.
+class AssetLoader {
+public:
+    // threadCount 0 uses one worker per hardware thread.
+    explicit AssetLoader(size_t threadCount = 0);
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void start(const AssetRequest* requests, size_t count);
+    void waitForCritical();
+    void wait();
+    // Moves finished sprites into the cache; returns how many were added.
+    size_t publish(ResourceManager& resources);
+    // Every asset was decoded and published.
+    bool isComplete() const;
+    AssetLoadStats getStats() const;
+
+private:
+    struct Slot {
+        std::string path;
+        bool critical = false;
+        bool done = false;
+        bool published = false;
+        std::unique_ptr<Sprite> sprite;
+    };
+
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<Slot> slots;
+    std::atomic<size_t> nextSlot{ 0 };
+    size_t unpublished = 0;
+    std::chrono::steady_clock::time_point startTime;
+
+    mutable std::mutex mutex;
+    std::condition_variable finished;
+    size_t criticalPending = 0;
+    size_t pending = 0;
+    AssetLoadStats stats;
+
+    void drain();
+    void decode(size_t index);
+};
@@ -0,0 +1,190 @@
+#include "Blitter.h"
+#include "BlitterKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+    void scalarCopyRow(uint32_t* dst, const uint32_t* src, int count) {
+        std::memcpy(dst, src, static_cast<size_t>(count) * sizeof(uint32_t));
+    }
+
+    void scalarBlendRow(uint32_t* dst, const uint32_t* src, int count) {
+        for (int i = 0; i < count; ++i) dst[i] = blit::blendPixel(src[i], dst[i]);
+    }
+
+    void scalarScaleCopyRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        for (int i = 0; i < count; ++i, u += du) dst[i] = src[u >> 16];
+    }
+
+    void scalarScaleBlendRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        for (int i = 0; i < count; ++i, u += du) dst[i] = blit::blendPixel(src[u >> 16], dst[i]);
+    }
+
+    const BlitKernels scalarTable = { scalarCopyRow, scalarBlendRow, scalarScaleCopyRow, scalarScaleBlendRow };
+
+    bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    const BlitKernels* tableFor(BlitIsa isa) {
+        switch (isa) {
+        case BlitIsa::Scalar: return &scalarTable;
+        case BlitIsa::SSE2: return blit::sse2Kernels();
+        case BlitIsa::AVX2: return cpuSupportsAvx2() ? blit::avx2Kernels() : nullptr;
+        default: return nullptr;
+        }
+    }
+
+    BlitIsa bestIsa() {
+        if (tableFor(BlitIsa::AVX2)) return BlitIsa::AVX2;
+        if (tableFor(BlitIsa::SSE2)) return BlitIsa::SSE2;
+        return BlitIsa::Scalar;
+    }
+
+    // Chosen on first use rather than during static initialisation.
+    BlitIsa activeIsa = BlitIsa::Scalar;
+    const BlitKernels* activeKernels = nullptr;
+
+    const BlitKernels& kernels() {
+        if (!activeKernels) setBlitIsa(bestIsa());
+        return *activeKernels;
+    }
+
+    // Intersects the destination rectangle with the clip and the surface.
+    bool clipRect(const Surface& dst, const ClipRect& clip, int x, int y, int width, int height, ClipRect& out) {
+        out.left = std::max({ x, clip.left, 0 });
+        out.top = std::max({ y, clip.top, 0 });
+        out.right = std::min({ x + width, clip.right, dst.width });
+        out.bottom = std::min({ y + height, clip.bottom, dst.height });
+        return !out.isEmpty();
+    }
+}
+
+namespace blit {
+    const BlitKernels& scalarKernels() { return scalarTable; }
+}
+
+bool isBlitIsaSupported(BlitIsa isa) { return tableFor(isa) != nullptr; }
+
+const char* getBlitIsaName(BlitIsa isa) {
+    switch (isa) {
+    case BlitIsa::Scalar: return "scalar";
+    case BlitIsa::SSE2: return "sse2";
+    case BlitIsa::AVX2: return "avx2";
+    default: return "unknown";
+    }
+}
+
+BlitIsa getBlitIsa() { kernels(); return activeIsa; }
+
+void setBlitIsa(BlitIsa isa) {
+    activeIsa = isBlitIsaSupported(isa) ? isa : bestIsa();
+    activeKernels = tableFor(activeIsa);
+}
+
+const BlitKernels& getBlitKernels() { return kernels(); }
+
+void fillSurface(const Surface& dst, const ClipRect& clip, int x, int y, int width, int height, uint32_t color) {
+    ClipRect r;
+    if (!clipRect(dst, clip, x, y, width, height, r)) return;
+    for (int row = r.top; row < r.bottom; ++row) std::fill(dst.row(row) + r.left, dst.row(row) + r.right, color);
+}
+
+void blitSurface(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, bool opaque) {
+    ClipRect r;
+    if (!clipRect(dst, clip, x, y, src.width, src.height, r)) return;
+    const BlitKernels& k = kernels();
+    int count = r.right - r.left;
+    // Whole rows of equally laid out surfaces are one contiguous block; a
+    // single large copy lets memcpy switch to streaming stores.
+    if (opaque && count == dst.width && count == src.width && dst.stride == count && src.stride == count && x == 0) {
+        std::memcpy(dst.row(r.top), src.row(r.top - y), static_cast<size_t>(count) * (r.bottom - r.top) * sizeof(uint32_t));
+        return;
+    }
+    auto rowFn = opaque ? k.copyRow : k.blendRow;
+    for (int row = r.top; row < r.bottom; ++row) rowFn(dst.row(row) + r.left, src.row(row - y) + (r.left - x), count);
+}
+
+// Nearest-neighbour, sampling at pixel centres so a 1:1 scale is an exact copy.
+void blitSurfaceScaled(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, int width, int height, bool opaque) {
+    if (width == src.width && height == src.height) { blitSurface(dst, clip, src, x, y, opaque); return; }
+    ClipRect r;
+    if (width <= 0 || height <= 0 || !clipRect(dst, clip, x, y, width, height, r)) return;
+    const BlitKernels& k = kernels();
+    auto rowFn = opaque ? k.scaleCopyRow : k.scaleBlendRow;
+    uint32_t du = static_cast<uint32_t>((static_cast<uint64_t>(src.width) << 16) / width);
+    uint32_t u = static_cast<uint32_t>(r.left - x) * du + (du >> 1);
+    int count = r.right - r.left;
+    for (int row = r.top; row < r.bottom; ++row) {
+        int sy = static_cast<int>((static_cast<int64_t>(row - y) * 2 + 1) * src.height / (2 * static_cast<int64_t>(height)));
+        rowFn(dst.row(row) + r.left, src.row(sy), count, u, du);
+    }
+}
+
+ClipRect getRotatedBounds(int x, int y, int width, int height, float degrees) {
+    if (width <= 0 || height <= 0) return ClipRect();
+    float radians = degrees * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    float cx = static_cast<float>(x + width / 2);
+    float cy = static_cast<float>(y + height / 2);
+    float extentX = std::fabs(width * 0.5f * c) + std::fabs(height * 0.5f * s) + 1.0f;
+    float extentY = std::fabs(width * 0.5f * s) + std::fabs(height * 0.5f * c) + 1.0f;
+    return { static_cast<int>(std::floor(cx - extentX)), static_cast<int>(std::floor(cy - extentY)),
+        static_cast<int>(std::ceil(cx + extentX)), static_cast<int>(std::ceil(cy + extentY)) };
+}
+
+// Rare enough (one small sprite per frame) that a scalar inverse mapping over
+// the rotated bounding box is plenty.
+void blitSurfaceRotated(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, int width, int height, float degrees) {
+    if (width <= 0 || height <= 0) return;
+    float radians = degrees * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    float cx = static_cast<float>(x + width / 2);
+    float cy = static_cast<float>(y + height / 2);
+
+    ClipRect r;
+    ClipRect bounds = getRotatedBounds(x, y, width, height, degrees);
+    if (!clipRect(dst, clip, bounds.left, bounds.top, bounds.right - bounds.left, bounds.bottom - bounds.top, r)) return;
+
+    float scaleX = static_cast<float>(src.width) / width;
+    float scaleY = static_cast<float>(src.height) / height;
+    // The sprite's own rectangle is anchored at (x, y), not at its centre.
+    float originX = cx - x;
+    float originY = cy - y;
+    for (int row = r.top; row < r.bottom; ++row) {
+        uint32_t* out = dst.row(row);
+        float dy = row + 0.5f - cy;
+        for (int col = r.left; col < r.right; ++col) {
+            float dx = col + 0.5f - cx;
+            float lx = dx * c + dy * s + originX;
+            float ly = -dx * s + dy * c + originY;
+            if (lx < 0.0f || ly < 0.0f || lx >= width || ly >= height) continue;
+            int sx = std::min(static_cast<int>(lx * scaleX), src.width - 1);
+            int sy = std::min(static_cast<int>(ly * scaleY), src.height - 1);
+            out[col] = blit::blendPixel(src.row(sy)[sx], out[col]);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Surface.h"
+#include <cstdint>
+
+// Pixel kernels for the software renderer. Each instruction set provides the
+// same row operations with bit-identical results; the best one the CPU
+// supports is picked at startup and can be overridden for benchmarking.
+enum class BlitIsa {
+    Scalar,
+    SSE2,
+    AVX2,
+    COUNT
+};
+
+struct BlitKernels {
+    // dst[i] = src[i]
+    void (*copyRow)(uint32_t* dst, const uint32_t* src, int count);
+    // Premultiplied source-over: dst = src + dst * (255 - srcAlpha) / 255
+    void (*blendRow)(uint32_t* dst, const uint32_t* src, int count);
+    // Nearest-neighbour: dst[i] takes src[(u + i * du) >> 16] (16.16 fixed point).
+    void (*scaleCopyRow)(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du);
+    void (*scaleBlendRow)(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du);
+};
+
+bool isBlitIsaSupported(BlitIsa isa);
+const char* getBlitIsaName(BlitIsa isa);
+BlitIsa getBlitIsa();
+// Falls back to the best supported instruction set if isa isn't available.
+void setBlitIsa(BlitIsa isa);
+const BlitKernels& getBlitKernels();
+
+// Surface operations. Everything is clipped against clip and the bounds of dst;
+// opaque sources skip blending entirely.
+void fillSurface(const Surface& dst, const ClipRect& clip, int x, int y, int width, int height, uint32_t color);
+void blitSurface(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, bool opaque);
+void blitSurfaceScaled(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, int width, int height, bool opaque);
+// Rotates clockwise by degrees around the centre of the destination rectangle.
+// getRotatedBounds is the (unclipped) area it may touch.
+ClipRect getRotatedBounds(int x, int y, int width, int height, float degrees);
+void blitSurfaceRotated(const Surface& dst, const ClipRect& clip, const Surface& src, int x, int y, int width, int height, float degrees);
@@ -0,0 +1,26 @@
+#pragma once
+#include "Blitter.h"
+
+// Per-instruction-set kernel tables. The SIMD tables are null when the
+// compiler or target can't build them.
+namespace blit {
+    const BlitKernels& scalarKernels();
+    const BlitKernels* sse2Kernels();
+    const BlitKernels* avx2Kernels();
+
+    // Shared by every implementation so tails and fallbacks match the SIMD
+    // results bit for bit: t = d * (255 - a) + 128, d' = (t + (t >> 8)) >> 8.
+    // Internal linkage keeps the copy compiled with AVX2 enabled from being
+    // the one the linker picks for every other translation unit.
+    static inline uint32_t blendPixel(uint32_t s, uint32_t d) {
+        uint32_t sa = s >> 24;
+        if (sa == 255) return s;
+        if (sa == 0) return d;
+        uint32_t ia = 255 - sa;
+        uint32_t rb = (d & 0x00FF00FFu) * ia + 0x00800080u;
+        rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+        uint32_t ag = ((d >> 8) & 0x00FF00FFu) * ia + 0x00800080u;
+        ag = (ag + ((ag >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+        return s + (rb | ag);
+    }
+}
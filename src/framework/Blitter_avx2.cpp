@@ -0,0 +1,74 @@
+#include "BlitterKernels.h"
+
+// Built with AVX2 code generation enabled (see CMakeLists.txt); only reached
+// after a runtime CPU check.
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+    // Eight premultiplied pixels over eight destination pixels; see blit::blendPixel.
+    inline __m256i blend8(__m256i s, __m256i d) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i bias = _mm256_set1_epi16(128);
+        __m256i ia = _mm256_sub_epi32(_mm256_set1_epi32(255), _mm256_srli_epi32(s, 24));
+        ia = _mm256_or_si256(ia, _mm256_slli_epi32(ia, 16));
+        __m256i iaLo = _mm256_unpacklo_epi32(ia, ia);
+        __m256i iaHi = _mm256_unpackhi_epi32(ia, ia);
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), iaLo), bias);
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), iaHi), bias);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        return _mm256_add_epi8(s, _mm256_packus_epi16(lo, hi));
+    }
+
+    inline void blendStore8(uint32_t* dst, __m256i s) {
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        __m256i alpha = _mm256_and_si256(s, alphaMask);
+        if (_mm256_testz_si256(alpha, alpha)) return;
+        __m256i* out = reinterpret_cast<__m256i*>(dst);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alphaMask)) == -1) { _mm256_storeu_si256(out, s); return; }
+        _mm256_storeu_si256(out, blend8(s, _mm256_loadu_si256(out)));
+    }
+
+    inline __m256i sampleIndices(uint32_t u, uint32_t du) {
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i uv = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(u)), _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int>(du))));
+        return _mm256_srli_epi32(uv, 16);
+    }
+
+    void copyRow(uint32_t* dst, const uint32_t* src, int count) {
+        int i = 0;
+        for (; i + 8 <= count; i += 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        for (; i < count; ++i) dst[i] = src[i];
+    }
+
+    void blendRow(uint32_t* dst, const uint32_t* src, int count) {
+        int i = 0;
+        for (; i + 8 <= count; i += 8) blendStore8(dst + i, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        for (; i < count; ++i) dst[i] = blit::blendPixel(src[i], dst[i]);
+    }
+
+    void scaleCopyRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        const int* base = reinterpret_cast<const int*>(src);
+        int i = 0;
+        for (; i + 8 <= count; i += 8, u += 8 * du) _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_i32gather_epi32(base, sampleIndices(u, du), 4));
+        for (; i < count; ++i, u += du) dst[i] = src[u >> 16];
+    }
+
+    void scaleBlendRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        const int* base = reinterpret_cast<const int*>(src);
+        int i = 0;
+        for (; i + 8 <= count; i += 8, u += 8 * du) blendStore8(dst + i, _mm256_i32gather_epi32(base, sampleIndices(u, du), 4));
+        for (; i < count; ++i, u += du) dst[i] = blit::blendPixel(src[u >> 16], dst[i]);
+    }
+
+    const BlitKernels table = { copyRow, blendRow, scaleCopyRow, scaleBlendRow };
+}
+
+const BlitKernels* blit::avx2Kernels() { return &table; }
+
+#else
+
+const BlitKernels* blit::avx2Kernels() { return nullptr; }
+
+#endif
@@ -0,0 +1,71 @@
+#include "BlitterKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+namespace {
+    // Four premultiplied pixels over four destination pixels; see blit::blendPixel.
+    inline __m128i blend4(__m128i s, __m128i d) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        __m128i ia = _mm_sub_epi32(_mm_set1_epi32(255), _mm_srli_epi32(s, 24));
+        ia = _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+        __m128i iaLo = _mm_unpacklo_epi32(ia, ia);
+        __m128i iaHi = _mm_unpackhi_epi32(ia, ia);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), iaLo), bias);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), iaHi), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        return _mm_add_epi8(s, _mm_packus_epi16(lo, hi));
+    }
+
+    void copyRow(uint32_t* dst, const uint32_t* src, int count) {
+        int i = 0;
+        for (; i + 4 <= count; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        for (; i < count; ++i) dst[i] = src[i];
+    }
+
+    void blendRow(uint32_t* dst, const uint32_t* src, int count) {
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i alpha = _mm_and_si128(s, alphaMask);
+            // Sprites are mostly fully transparent or fully opaque runs.
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, _mm_setzero_si128())) == 0xFFFF) continue;
+            __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) { _mm_storeu_si128(out, s); continue; }
+            _mm_storeu_si128(out, blend4(s, _mm_loadu_si128(out)));
+        }
+        for (; i < count; ++i) dst[i] = blit::blendPixel(src[i], dst[i]);
+    }
+
+    // SSE2 has no gather, so sampled pixels are staged and then run through the
+    // row kernels.
+    constexpr int STAGE_PIXELS = 64;
+
+    void scaleCopyRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        for (int i = 0; i < count; ++i, u += du) dst[i] = src[u >> 16];
+    }
+
+    void scaleBlendRow(uint32_t* dst, const uint32_t* src, int count, uint32_t u, uint32_t du) {
+        alignas(16) uint32_t stage[STAGE_PIXELS];
+        while (count > 0) {
+            int n = count < STAGE_PIXELS ? count : STAGE_PIXELS;
+            for (int i = 0; i < n; ++i, u += du) stage[i] = src[u >> 16];
+            blendRow(dst, stage, n);
+            dst += n;
+            count -= n;
+        }
+    }
+
+    const BlitKernels table = { copyRow, blendRow, scaleCopyRow, scaleBlendRow };
+}
+
+const BlitKernels* blit::sse2Kernels() { return &table; }
+
+#else
+
+const BlitKernels* blit::sse2Kernels() { return nullptr; }
+
+#endif
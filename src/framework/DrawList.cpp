@@ -0,0 +1,145 @@
+#include "DrawList.h"
+#include "Blitter.h"
+#include <algorithm>
+#include <tuple>
+
+namespace {
+    // Merging costs a little extra fill but saves a pass over the draw list.
+    constexpr long long MERGE_SLACK = 32 * 32;
+    // Past this share of the screen a single full redraw wins.
+    constexpr long long FULL_REDRAW_PERCENT = 70;
+
+    auto key(const DrawCommand& c) {
+        return std::make_tuple(c.type, c.source, c.x, c.y, c.width, c.height, c.degrees, c.color, c.opaque);
+    }
+}
+
+bool DrawCommand::operator==(const DrawCommand& other) const { return key(*this) == key(other); }
+bool DrawCommand::operator<(const DrawCommand& other) const { return key(*this) < key(other); }
+
+void DrawList::blit(const Surface& source, int x, int y, int width, int height, bool opaque) {
+    DrawCommand command;
+    command.type = DrawCommand::Type::Blit;
+    command.opaque = opaque;
+    command.source = &source;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.bounds = { x, y, x + width, y + height };
+    commands.push_back(command);
+    sortedValid = false;
+}
+
+void DrawList::rotatedBlit(const Surface& source, int x, int y, int width, int height, float degrees) {
+    DrawCommand command;
+    command.type = DrawCommand::Type::RotatedBlit;
+    command.source = &source;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.degrees = degrees;
+    command.bounds = getRotatedBounds(x, y, width, height, degrees);
+    commands.push_back(command);
+    sortedValid = false;
+}
+
+void DrawList::fill(int x, int y, int width, int height, uint32_t color) {
+    DrawCommand command;
+    command.type = DrawCommand::Type::Fill;
+    command.opaque = true;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.color = color;
+    command.bounds = { x, y, x + width, y + height };
+    commands.push_back(command);
+    sortedValid = false;
+}
+
+const std::vector<DrawCommand>& DrawList::getSortedCommands() const {
+    if (!sortedValid) {
+        sorted.assign(commands.begin(), commands.end());
+        std::sort(sorted.begin(), sorted.end());
+        sortedValid = true;
+    }
+    return sorted;
+}
+
+void DrawList::replay(const Surface& dst, const ClipRect& clip) const {
+    for (const DrawCommand& command : commands) {
+        if (command.bounds.intersects(clip)) executeDrawCommand(command, dst, clip);
+    }
+}
+
+void executeDrawCommand(const DrawCommand& command, const Surface& dst, const ClipRect& clip) {
+    switch (command.type) {
+    case DrawCommand::Type::Blit:
+        blitSurfaceScaled(dst, clip, *command.source, command.x, command.y, command.width, command.height, command.opaque);
+        break;
+    case DrawCommand::Type::RotatedBlit:
+        blitSurfaceRotated(dst, clip, *command.source, command.x, command.y, command.width, command.height, command.degrees);
+        break;
+    case DrawCommand::Type::Fill:
+        fillSurface(dst, clip, command.x, command.y, command.width, command.height, command.color);
+        break;
+    }
+}
+
+// Matched as multisets, so an entity leaving the middle of a list doesn't
+// shift everything after it into the damage.
+void collectDamage(const DrawList& previous, const DrawList& current, FrameVector<ClipRect>& damage) {
+    const std::vector<DrawCommand>& before = previous.getSortedCommands();
+    const std::vector<DrawCommand>& after = current.getSortedCommands();
+
+    auto b = before.begin();
+    auto a = after.begin();
+    while (b != before.end() || a != after.end()) {
+        if (a == after.end() || (b != before.end() && *b < *a)) damage.push_back((b++)->bounds);
+        else if (b == before.end() || *a < *b) damage.push_back((a++)->bounds);
+        else { ++a; ++b; }
+    }
+}
+
+bool coalesceDamage(FrameVector<ClipRect>& rects, const ClipRect& bounds, size_t maxRects) {
+    size_t count = 0;
+    for (const ClipRect& rect : rects) {
+        ClipRect clipped = rect.intersection(bounds);
+        if (!clipped.isEmpty()) rects[count++] = clipped;
+    }
+    rects.resize(count);
+
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                ClipRect both = rects[i].united(rects[j]);
+                if (both.area() > rects[i].area() + rects[j].area() + MERGE_SLACK) continue;
+                rects[i] = both;
+                rects.erase(rects.begin() + j);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    // Still too many: fold the smallest pairs together until the cap holds.
+    while (rects.size() > maxRects) {
+        size_t bestI = 0, bestJ = 1;
+        long long bestGrowth = -1;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                long long growth = rects[i].united(rects[j]).area() - rects[i].area() - rects[j].area();
+                if (bestGrowth < 0 || growth < bestGrowth) { bestGrowth = growth; bestI = i; bestJ = j; }
+            }
+        }
+        rects[bestI] = rects[bestI].united(rects[bestJ]);
+        rects.erase(rects.begin() + bestJ);
+    }
+
+    long long area = 0;
+    for (const ClipRect& rect : rects) area += rect.area();
+    return area * 100 < bounds.area() * FULL_REDRAW_PERCENT;
+}
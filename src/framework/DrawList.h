@@ -0,0 +1,63 @@
+#pragma once
+#include "FrameArena.h"
+#include "Surface.h"
+#include <cstdint>
+#include <vector>
+
+// One deferred drawing call. Two commands are equal when they would put the
+// same pixels in the same place, which is what damage tracking compares.
+struct DrawCommand {
+    enum class Type : uint8_t {
+        Blit,
+        RotatedBlit,
+        Fill
+    };
+
+    Type type = Type::Fill;
+    bool opaque = false;
+    const Surface* source = nullptr;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    float degrees = 0.0f;
+    uint32_t color = 0;
+    ClipRect bounds;    // every pixel the command may touch
+
+    bool operator==(const DrawCommand& other) const;
+    bool operator<(const DrawCommand& other) const;
+};
+
+// The drawing calls of one frame, in order, so they can be replayed into just
+// the regions that changed since the last frame.
+class DrawList {
+private:
+    std::vector<DrawCommand> commands;
+    // Built on demand for damage tracking; both keep their capacity across
+    // frames so steady-state frames don't allocate.
+    mutable std::vector<DrawCommand> sorted;
+    mutable bool sortedValid = false;
+
+public:
+    void clear() { commands.clear(); sortedValid = false; }
+    void reserve(size_t count) { commands.reserve(count); sorted.reserve(count); }
+    void blit(const Surface& source, int x, int y, int width, int height, bool opaque);
+    void rotatedBlit(const Surface& source, int x, int y, int width, int height, float degrees);
+    void fill(int x, int y, int width, int height, uint32_t color);
+
+    const std::vector<DrawCommand>& getCommands() const { return commands; }
+    const std::vector<DrawCommand>& getSortedCommands() const;
+    void replay(const Surface& dst, const ClipRect& clip) const;
+};
+
+void executeDrawCommand(const DrawCommand& command, const Surface& dst, const ClipRect& clip);
+
+// Collects the bounds of every command that appears in only one of the two
+// frames. A command that merely moved contributes both its old and its new
+// bounds.
+void collectDamage(const DrawList& previous, const DrawList& current, FrameVector<ClipRect>& damage);
+
+// Clips rects to bounds, merges overlapping or nearly adjacent ones and caps
+// the count at maxRects by merging further. Returns false when the result
+// covers so much of bounds that a full redraw is cheaper.
+bool coalesceDamage(FrameVector<ClipRect>& rects, const ClipRect& bounds, size_t maxRects);
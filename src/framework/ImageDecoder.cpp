@@ -0,0 +1,166 @@
+#include "ImageDecoder.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <gdiplus.h>
+#pragma comment(lib, "gdiplus.lib")
+#else
+#ifdef DOODLE_HAVE_PNG
+#include <png.h>
+#endif
+#ifdef DOODLE_HAVE_JPEG
+#include <jpeglib.h>
+#include <csetjmp>
+#endif
+#endif
+
+bool premultiplyPixels(uint32_t* pixels, size_t count) {
+    bool opaque = true;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t p = pixels[i];
+        uint32_t a = p >> 24;
+        if (a == 255) continue;
+        opaque = false;
+        uint32_t b = ((p & 0xFF) * a + 127) / 255;
+        uint32_t g = (((p >> 8) & 0xFF) * a + 127) / 255;
+        uint32_t r = (((p >> 16) & 0xFF) * a + 127) / 255;
+        pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+    }
+    return opaque;
+}
+
+namespace {
+#ifdef _WIN32
+    std::wstring convertToWideString(const char* str) {
+        int size = MultiByteToWideChar(CP_UTF8, 0, str, -1, nullptr, 0);
+        std::wstring wstr(size - 1, 0);
+        MultiByteToWideChar(CP_UTF8, 0, str, -1, &wstr[0], size);
+        return wstr;
+    }
+
+    // GDI+ converts straight into our layout, so the bitmap is only touched once.
+    bool decodeGdiplus(const char* path, DecodedImage& image) {
+        Gdiplus::Bitmap bitmap(convertToWideString(path).c_str());
+        if (bitmap.GetLastStatus() != Gdiplus::Ok) return false;
+
+        image.width = static_cast<int>(bitmap.GetWidth());
+        image.height = static_cast<int>(bitmap.GetHeight());
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0);
+
+        Gdiplus::Rect rect(0, 0, image.width, image.height);
+        Gdiplus::BitmapData data = {};
+        data.Width = image.width;
+        data.Height = image.height;
+        data.Stride = image.width * 4;
+        data.PixelFormat = PixelFormat32bppPARGB;
+        data.Scan0 = image.pixels.data();
+        if (bitmap.LockBits(&rect, Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeUserInputBuf, PixelFormat32bppPARGB, &data) != Gdiplus::Ok) return false;
+        bitmap.UnlockBits(&data);
+
+        image.opaque = true;
+        for (uint32_t p : image.pixels) if ((p >> 24) != 255) { image.opaque = false; break; }
+        return true;
+    }
+#else
+#ifdef DOODLE_HAVE_PNG
+    bool decodePng(const char* path, DecodedImage& image) {
+        png_image png;
+        std::memset(&png, 0, sizeof(png));
+        png.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_file(&png, path)) return false;
+
+        png.format = PNG_FORMAT_BGRA;
+        image.width = static_cast<int>(png.width);
+        image.height = static_cast<int>(png.height);
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0);
+        if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) { png_image_free(&png); return false; }
+
+        image.opaque = premultiplyPixels(image.pixels.data(), image.pixels.size());
+        return true;
+    }
+#endif
+
+#ifdef DOODLE_HAVE_JPEG
+    struct JpegError {
+        jpeg_error_mgr mgr;
+        std::jmp_buf jump;
+    };
+
+    void onJpegError(j_common_ptr info) { std::longjmp(reinterpret_cast<JpegError*>(info->err)->jump, 1); }
+
+    bool decodeJpeg(const char* path, DecodedImage& image) {
+        FILE* file = std::fopen(path, "rb");
+        if (!file) return false;
+
+        jpeg_decompress_struct info;
+        JpegError error;
+        info.err = jpeg_std_error(&error.mgr);
+        error.mgr.error_exit = onJpegError;
+        std::vector<unsigned char> scanline;
+        if (setjmp(error.jump)) { jpeg_destroy_decompress(&info); std::fclose(file); return false; }
+
+        jpeg_create_decompress(&info);
+        jpeg_stdio_src(&info, file);
+        jpeg_read_header(&info, TRUE);
+        info.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&info);
+
+        image.width = static_cast<int>(info.output_width);
+        image.height = static_cast<int>(info.output_height);
+        image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0);
+        scanline.resize(static_cast<size_t>(image.width) * 3);
+        while (info.output_scanline < info.output_height) {
+            uint32_t* out = image.pixels.data() + static_cast<size_t>(info.output_scanline) * image.width;
+            JSAMPROW row = scanline.data();
+            jpeg_read_scanlines(&info, &row, 1);
+            for (int x = 0; x < image.width; ++x) {
+                const unsigned char* rgb = &scanline[x * 3];
+                out[x] = 0xFF000000u | (uint32_t(rgb[0]) << 16) | (uint32_t(rgb[1]) << 8) | rgb[2];
+            }
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+        std::fclose(file);
+        image.opaque = true;
+        return true;
+    }
+#endif
+
+#if defined(DOODLE_HAVE_PNG) || defined(DOODLE_HAVE_JPEG)
+    bool hasExtension(const char* path, const char* ext) {
+        size_t length = std::strlen(path);
+        size_t extLength = std::strlen(ext);
+        if (length < extLength) return false;
+        for (size_t i = 0; i < extLength; ++i) {
+            char c = path[length - extLength + i];
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            if (c != ext[i]) return false;
+        }
+        return true;
+    }
+#endif
+#endif
+}
+
+bool decodeImage(const char* path, DecodedImage& image) {
+    if (!path) return false;
+#ifdef _WIN32
+    return decodeGdiplus(path, image);
+#else
+#ifdef DOODLE_HAVE_JPEG
+    if (hasExtension(path, ".jpg") || hasExtension(path, ".jpeg")) return decodeJpeg(path, image);
+#endif
+#ifdef DOODLE_HAVE_PNG
+    if (hasExtension(path, ".png")) return decodePng(path, image);
+#endif
+    (void)image; // unused when built without either library
+#ifdef _DEBUG
+    printf("No decoder for %s\n", path);
+#endif
+    return false;
+#endif
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint32_t> pixels;   // premultiplied BGRA, tightly packed
+    bool opaque = true;
+};
+
+// Decodes a PNG or JPEG from disk. Uses GDI+ on Windows and libpng/libjpeg
+// elsewhere; returns false if the file can't be read or no decoder was built.
+bool decodeImage(const char* path, DecodedImage& image);
+
+// Converts straight-alpha BGRA in place and reports whether every pixel is opaque.
+bool premultiplyPixels(uint32_t* pixels, size_t count);
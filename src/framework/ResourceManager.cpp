@@ -0,0 +1,44 @@
+#include "ResourceManager.h"
+
+ResourceManager* ResourceManager::instance = nullptr;
+
+ResourceManager& ResourceManager::getInstance() {
+    if (!instance) instance = new ResourceManager();
+    return *instance;
+}
+
+SpriteHandle ResourceManager::loadSprite(const char* path) {
+    if (!path) return nullptr;
+
+    auto it = sprites.find(path);
+    if (it != sprites.end()) { ++stats.hits; return it->second; }
+
+    // Failed loads are cached as well so a missing file is only probed once.
+    ++stats.misses;
+    SpriteHandle sprite(createSprite(path));
+    addSprite(path, sprite);
+    return sprite;
+}
+
+SpriteHandle ResourceManager::findSprite(const char* path) const {
+    if (!path) return nullptr;
+    auto it = sprites.find(path);
+    return it != sprites.end() ? it->second : nullptr;
+}
+
+void ResourceManager::addSprite(const char* path, SpriteHandle sprite) {
+    if (!path) return;
+    auto [it, inserted] = sprites.emplace(path, sprite);
+    if (!inserted) return;
+    if (sprite) stats.bytesResident += static_cast<size_t>(sprite->getSurface().width) * sprite->getSurface().height * sizeof(uint32_t);
+}
+
+void ResourceManager::cleanup() {
+    sprites.clear();
+    stats = ResourceStats();
+}
+
+ResourceManager::~ResourceManager() {
+    cleanup();
+    if (instance == this) instance = nullptr;
+}
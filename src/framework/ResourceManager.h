@@ -0,0 +1,38 @@
+#pragma once
+#include "framework.h"
+#include <map>
+#include <memory>
+#include <string>
+
+// Sprites handed out by the cache are shared and immutable: every entity that
+// references the same file points at the same decoded bitmap.
+using SpriteHandle = std::shared_ptr<const Sprite>;
+
+struct ResourceStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t bytesResident = 0;
+};
+
+class ResourceManager {
+private:
+    std::map<std::string, SpriteHandle, std::less<>> sprites;
+    ResourceStats stats;
+    static ResourceManager* instance;
+
+    ResourceManager() = default;
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+public:
+    static ResourceManager& getInstance();
+    SpriteHandle loadSprite(const char* path);
+    // Cached sprite for path, or null; never touches the disk.
+    SpriteHandle findSprite(const char* path) const;
+    // Caches a sprite decoded elsewhere (see AssetLoader); a null one records a failed load.
+    void addSprite(const char* path, SpriteHandle sprite);
+    const ResourceStats& getStats() const { return stats; }
+    size_t getSpriteCount() const { return sprites.size(); }
+    void cleanup();
+    ~ResourceManager();
+};
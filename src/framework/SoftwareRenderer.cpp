@@ -0,0 +1,241 @@
+#define FRAMEWORK_PROJECT
+#include "framework.h"
+#include "AssetArchive.h"
+#include "Blitter.h"
+#include "DrawList.h"
+#include "ImageDecoder.h"
+#include "Profiler.h"
+#include "TileCompositor.h"
+#include <cstdio>
+#include <memory>
+
+// The drawing half of the framework API. Everything renders into one 32bpp
+// premultiplied back buffer, so the same code runs under the Win32 window
+// and headless on any platform.
+//
+// Outside beginFrame/endFrame every call draws immediately. Inside, calls
+// are only recorded; endFrame compares the list with the previous frame's,
+// restores the changed regions from a cached copy of the background and
+// replays the list clipped to each of them, split into tiles across threads.
+namespace {
+    Surface framebuffer;
+    std::vector<uint32_t> framebufferStorage;
+    ClipRect framebufferClip;
+    Sprite* backgroundSprite = nullptr;
+    Sprite* scoreSprite = nullptr;
+
+    const uint32_t BACKGROUND_FALLBACK_COLOR = 0xFF808080;
+    const size_t MAX_DIRTY_RECTS = 16;
+    // Comfortably above a busy game frame, so recording never has to grow
+    // the lists mid-game. They outlive a frame, so they can't use the arena.
+    const size_t DRAW_LIST_CAPACITY = 512;
+    // Damage and tile bins of a frame. Sized for a 4K-resolution frame with
+    // room to spare: --debug reports a high water of about 1.1 KB at the
+    // default window and 9.1 KB at 3840x2160.
+    const size_t FRAME_ARENA_CAPACITY = 64 * 1024;
+
+    bool inFrame = false;
+    bool fullRedraw = true;
+    DrawList currentFrame;
+    DrawList previousFrame;
+    // Reset by beginFrame; endFrame's scratch data lives here until then.
+    FrameArena frameArena(FRAME_ARENA_CAPACITY);
+    FrameVector<ClipRect> dirtyRects{ ArenaAllocator<ClipRect>(frameArena) };
+    std::vector<uint32_t> backgroundCache;
+    bool backgroundCacheValid = false;
+    size_t renderThreads = 0;
+    AssetArchive assetArchive;
+    std::unique_ptr<TileCompositor> compositor;
+
+    // The backdrop is stretched over the whole back buffer and the score bar
+    // across its width, whatever the window size.
+    void drawBackground(const Surface& dst, const ClipRect& clip) {
+        fillSurface(dst, clip, 0, 0, dst.width, dst.height, BACKGROUND_FALLBACK_COLOR);
+        if (!backgroundSprite || !scoreSprite) return;
+        blitSurfaceScaled(dst, clip, backgroundSprite->getSurface(), 0, 0, dst.width, dst.height, backgroundSprite->isOpaque());
+        blitSurfaceScaled(dst, clip, scoreSprite->getSurface(), 0, 0, dst.width, scoreSprite->getHeight(), scoreSprite->isOpaque());
+    }
+
+    // The static layers, composited in the back buffer's format and size once
+    // per background change or resize. A frame's background is then one
+    // straight copy.
+    Surface backgroundSurface() {
+        Surface cache = { nullptr, framebuffer.width, framebuffer.height, framebuffer.width };
+        if (!backgroundCacheValid) {
+            backgroundCache.assign(static_cast<size_t>(framebuffer.width) * framebuffer.height, 0);
+            cache.pixels = backgroundCache.data();
+            drawBackground(cache, framebufferClip);
+            backgroundCacheValid = true;
+        }
+        cache.pixels = backgroundCache.data();
+        return cache;
+    }
+
+    void invalidateBackground() {
+        backgroundCacheValid = false;
+        fullRedraw = true;
+    }
+
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    FRAMEWORK_API bool createFramebuffer(int width, int height, uint32_t* pixels) {
+        if (width <= 0 || height <= 0) return false;
+        if (pixels) framebufferStorage.clear();
+        else {
+            framebufferStorage.assign(static_cast<size_t>(width) * height, 0);
+            pixels = framebufferStorage.data();
+        }
+        framebuffer = { pixels, width, height, width };
+        framebufferClip = { 0, 0, width, height };
+        currentFrame.reserve(DRAW_LIST_CAPACITY);
+        previousFrame.reserve(DRAW_LIST_CAPACITY);
+        invalidateBackground();
+        return true;
+    }
+
+    FRAMEWORK_API void destroyFramebuffer() {
+        framebuffer = Surface();
+        framebufferClip = ClipRect();
+        std::vector<uint32_t>().swap(framebufferStorage);
+        std::vector<uint32_t>().swap(backgroundCache);
+        currentFrame.clear();
+        previousFrame.clear();
+        inFrame = false;
+        invalidateBackground();
+    }
+
+    FRAMEWORK_API const Surface* getFramebuffer() { return framebuffer.pixels ? &framebuffer : nullptr; }
+
+    FRAMEWORK_API Sprite* getGameScoreSprite() { return scoreSprite; }
+
+    FRAMEWORK_API void setBackgroundSprite(const char* path) { delete backgroundSprite; backgroundSprite = createSprite(path); invalidateBackground(); }
+
+    FRAMEWORK_API void setScoreSprite(const char* path) { delete scoreSprite; scoreSprite = createSprite(path); invalidateBackground(); }
+
+    // The layers are wrapped in sprites that borrow the caller's pixels.
+    FRAMEWORK_API void setBackgroundLayers(const Sprite* backdrop, const Sprite* scoreBar) {
+        delete backgroundSprite;
+        delete scoreSprite;
+        backgroundSprite = backdrop ? new Sprite(backdrop->getSurface(), backdrop->isOpaque()) : nullptr;
+        scoreSprite = scoreBar ? new Sprite(scoreBar->getSurface(), scoreBar->isOpaque()) : nullptr;
+        if (scoreSprite) scoreSprite->setSize(scoreBar->getWidth(), scoreBar->getHeight());
+        invalidateBackground();
+    }
+
+    FRAMEWORK_API bool hasBackgroundLayers() { return backgroundSprite && scoreSprite; }
+
+    FRAMEWORK_API bool mountAssetArchive(const char* path) { return path && assetArchive.open(path); }
+
+    FRAMEWORK_API void unmountAssetArchive() { assetArchive.close(); }
+
+    // Packed sprites borrow the mapped pixels; anything the archive lacks or
+    // fails to verify is decoded from the file as before.
+    FRAMEWORK_API Sprite* createSprite(const char* path) {
+        if (!path) return nullptr;
+
+        Surface packed;
+        bool packedOpaque;
+        if (assetArchive.find(path, packed, packedOpaque)) return new Sprite(packed, packedOpaque);
+
+        DecodedImage image;
+        try {
+            if (!decodeImage(path, image)) return nullptr;
+            return new Sprite(image.width, image.height, std::move(image.pixels), image.opaque);
+        }
+        catch (const std::exception& e) {
+#ifdef _DEBUG
+            printf("Exception while loading sprite: %s - %s\n", path, e.what());
+#endif
+            return nullptr;
+        }
+    }
+
+    FRAMEWORK_API void drawSprite(const Sprite* sprite, int x, int y) {
+        if (!sprite || !framebuffer.pixels) return;
+        if (inFrame) currentFrame.blit(sprite->getSurface(), x, y, sprite->getWidth(), sprite->getHeight(), sprite->isOpaque());
+        else blitSurfaceScaled(framebuffer, framebufferClip, sprite->getSurface(), x, y, sprite->getWidth(), sprite->getHeight(), sprite->isOpaque());
+    }
+
+    FRAMEWORK_API void drawSpriteRotated(const Sprite* sprite, int x, int y, float angle) {
+        if (!sprite || !framebuffer.pixels) return;
+        if (inFrame) currentFrame.rotatedBlit(sprite->getSurface(), x, y, sprite->getWidth(), sprite->getHeight(), angle);
+        else blitSurfaceRotated(framebuffer, framebufferClip, sprite->getSurface(), x, y, sprite->getWidth(), sprite->getHeight(), angle);
+    }
+
+    FRAMEWORK_API void fillRect(int x, int y, int width, int height, uint32_t color) {
+        if (!framebuffer.pixels) return;
+        if (inFrame) currentFrame.fill(x, y, width, height, color);
+        else fillSurface(framebuffer, framebufferClip, x, y, width, height, color);
+    }
+
+    FRAMEWORK_API void getSpriteSize(const Sprite* sprite, int& width, int& height) {
+        if (!sprite) return;
+        width = sprite->getWidth();
+        height = sprite->getHeight();
+    }
+
+    FRAMEWORK_API void setSpriteSize(Sprite* sprite, int width, int height) {
+        if (!sprite) return;
+        sprite->setSize(width, height);
+    }
+
+    // The previous frame may still reference the sprite, and a new one could
+    // be allocated at the same address.
+    FRAMEWORK_API void destroySprite(Sprite* sprite) { delete sprite; fullRedraw = true; }
+
+    FRAMEWORK_API void drawTestBackground() {
+        DJ_PROFILE_ZONE("drawTestBackground");
+        if (inFrame || !framebuffer.pixels) return;
+        blitSurface(framebuffer, framebufferClip, backgroundSurface(), 0, 0, true);
+    }
+
+    FRAMEWORK_API void beginFrame() {
+        frameArena.reset();
+        currentFrame.clear();
+        inFrame = framebuffer.pixels != nullptr;
+    }
+
+    FRAMEWORK_API const ClipRect* endFrame(int& count) {
+        DJ_PROFILE_ZONE("endFrame");
+        count = 0;
+        if (!inFrame) return nullptr;
+        inFrame = false;
+
+        // Damage holds up to one rect per command of either frame before it is coalesced.
+        dirtyRects = FrameVector<ClipRect>(ArenaAllocator<ClipRect>(frameArena));
+        dirtyRects.reserve(previousFrame.getCommands().size() + currentFrame.getCommands().size() + 1);
+        if (!fullRedraw) {
+            collectDamage(previousFrame, currentFrame, dirtyRects);
+            if (!coalesceDamage(dirtyRects, framebufferClip, MAX_DIRTY_RECTS)) fullRedraw = true;
+        }
+        if (fullRedraw) {
+            dirtyRects.assign(1, framebufferClip);
+            fullRedraw = false;
+        }
+
+        if (!compositor) compositor = std::make_unique<TileCompositor>(renderThreads, frameArena);
+        compositor->render(currentFrame, framebuffer, backgroundSurface(), dirtyRects.data(), dirtyRects.size());
+        std::swap(previousFrame, currentFrame);
+        count = static_cast<int>(dirtyRects.size());
+        return dirtyRects.data();
+    }
+
+    FRAMEWORK_API void invalidateFramebuffer() { fullRedraw = true; }
+
+    FRAMEWORK_API FrameArena& getFrameArena() { return frameArena; }
+
+    FRAMEWORK_API void setRenderThreads(int threads) {
+        renderThreads = threads > 0 ? static_cast<size_t>(threads) : 0;
+        compositor.reset();
+    }
+
+    FRAMEWORK_API void getScreenSize(int& width, int& height) {
+        width = framebuffer.width; height = framebuffer.height;
+    }
+
+#ifdef __cplusplus
+}
+#endif
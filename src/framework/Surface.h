@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// A view of 32bpp premultiplied BGRA pixels, laid out like a top-down Win32
+// DIB section (0xAARRGGBB per pixel). Stride is in pixels. A Surface never
+// owns its memory.
+struct Surface {
+    uint32_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+
+    uint32_t* row(int y) const { return pixels + static_cast<ptrdiff_t>(y) * stride; }
+};
+
+// Half-open pixel rectangle [left, right) x [top, bottom).
+struct ClipRect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    bool isEmpty() const { return right <= left || bottom <= top; }
+    long long area() const { return isEmpty() ? 0 : static_cast<long long>(right - left) * (bottom - top); }
+    bool intersects(const ClipRect& other) const {
+        return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+    }
+    ClipRect intersection(const ClipRect& other) const {
+        return { left > other.left ? left : other.left, top > other.top ? top : other.top,
+            right < other.right ? right : other.right, bottom < other.bottom ? bottom : other.bottom };
+    }
+    // Smallest rectangle covering both; an empty side is ignored.
+    ClipRect united(const ClipRect& other) const {
+        if (isEmpty()) return other;
+        if (other.isEmpty()) return *this;
+        return { left < other.left ? left : other.left, top < other.top ? top : other.top,
+            right > other.right ? right : other.right, bottom > other.bottom ? bottom : other.bottom };
+    }
+    bool operator==(const ClipRect& other) const {
+        return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+    }
+};
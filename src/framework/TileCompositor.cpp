@@ -0,0 +1,139 @@
+#include "TileCompositor.h"
+#include "Blitter.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace {
+    // A fresh vector of count copies of value in the arena; the old storage
+    // belonged to a previous frame.
+    template <typename T>
+    void frameAssign(FrameVector<T>& v, FrameArena& arena, size_t count, T value) {
+        v = FrameVector<T>(count, value, ArenaAllocator<T>(arena));
+    }
+}
+
+TileCompositor::TileCompositor(size_t threads, FrameArena& frameArena)
+    : threadCount(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    , arena(frameArena)
+    , tileDirty(ArenaAllocator<uint8_t>(frameArena))
+    , activeTiles(ArenaAllocator<uint32_t>(frameArena))
+    , binStart(ArenaAllocator<uint32_t>(frameArena))
+    , binFill(ArenaAllocator<uint32_t>(frameArena))
+    , binCommands(ArenaAllocator<uint32_t>(frameArena))
+{
+    for (size_t i = 1; i < threadCount; ++i) workers.emplace_back(&TileCompositor::workerLoop, this);
+}
+
+TileCompositor::~TileCompositor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void TileCompositor::render(const DrawList& drawList, const Surface& target, const Surface& backgroundLayer, const ClipRect* dirty, size_t dirtyCount) {
+    DJ_PROFILE_ZONE("TileCompositor::render");
+    list = &drawList;
+    dst = target;
+    background = backgroundLayer;
+    rects = dirty;
+    rectCount = dirtyCount;
+    tilesX = (dst.width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (dst.height + TILE_SIZE - 1) / TILE_SIZE;
+    bin();
+    // Resolve the blit kernels here so workers never race on the first-use setup.
+    getBlitKernels();
+
+    long long pixels = 0;
+    for (size_t i = 0; i < rectCount; ++i) pixels += rects[i].area();
+
+    nextTile.store(0, std::memory_order_relaxed);
+    if (workers.empty() || pixels < MIN_PARALLEL_PIXELS || activeTiles.size() < 2) { drainTiles(); return; }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        running = workers.size();
+    }
+    wake.notify_all();
+    drainTiles();
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return running == 0; });
+}
+
+void TileCompositor::workerLoop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+        lock.unlock();
+        drainTiles();
+        lock.lock();
+        if (--running == 0) finished.notify_one();
+    }
+}
+
+// Tiles touched by a dirty rect are the work items; every command lands in
+// the bin of each such tile its bounds overlap. Counted first, then filled,
+// so the bins share one flat array.
+void TileCompositor::bin() {
+    size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+    frameAssign<uint8_t>(tileDirty, arena, tileCount, 0);
+    frameAssign<uint32_t>(binStart, arena, tileCount + 1, 0);
+    frameAssign<uint32_t>(activeTiles, arena, 0, 0);
+    activeTiles.reserve(tileCount);
+
+    ClipRect screen = { 0, 0, dst.width, dst.height };
+    auto forEachTile = [&](const ClipRect& area, auto fn) {
+        ClipRect r = area.intersection(screen);
+        if (r.isEmpty()) return;
+        for (int ty = r.top / TILE_SIZE; ty <= (r.bottom - 1) / TILE_SIZE; ++ty)
+            for (int tx = r.left / TILE_SIZE; tx <= (r.right - 1) / TILE_SIZE; ++tx) fn(static_cast<uint32_t>(ty * tilesX + tx));
+    };
+
+    for (size_t i = 0; i < rectCount; ++i) {
+        forEachTile(rects[i], [&](uint32_t tile) {
+            if (!tileDirty[tile]) { tileDirty[tile] = 1; activeTiles.push_back(tile); }
+        });
+    }
+
+    const std::vector<DrawCommand>& commands = list->getCommands();
+    for (const DrawCommand& command : commands)
+        forEachTile(command.bounds, [&](uint32_t tile) { binStart[tile + 1] += tileDirty[tile]; });
+    for (size_t t = 0; t < tileCount; ++t) binStart[t + 1] += binStart[t];
+
+    frameAssign<uint32_t>(binCommands, arena, binStart[tileCount], 0);
+    frameAssign<uint32_t>(binFill, arena, tileCount, 0);
+    std::copy(binStart.begin(), binStart.end() - 1, binFill.begin());
+    for (size_t i = 0; i < commands.size(); ++i) {
+        forEachTile(commands[i].bounds, [&](uint32_t tile) {
+            if (tileDirty[tile]) binCommands[binFill[tile]++] = static_cast<uint32_t>(i);
+        });
+    }
+}
+
+void TileCompositor::drainTiles() {
+    for (size_t i = nextTile.fetch_add(1, std::memory_order_relaxed); i < activeTiles.size(); i = nextTile.fetch_add(1, std::memory_order_relaxed))
+        renderTile(activeTiles[i]);
+}
+
+void TileCompositor::renderTile(uint32_t tile) {
+    int tx = static_cast<int>(tile) % tilesX;
+    int ty = static_cast<int>(tile) / tilesX;
+    ClipRect tileRect = { tx * TILE_SIZE, ty * TILE_SIZE, std::min((tx + 1) * TILE_SIZE, dst.width), std::min((ty + 1) * TILE_SIZE, dst.height) };
+    const std::vector<DrawCommand>& commands = list->getCommands();
+
+    for (size_t r = 0; r < rectCount; ++r) {
+        ClipRect clip = rects[r].intersection(tileRect);
+        if (clip.isEmpty()) continue;
+        blitSurface(dst, clip, background, 0, 0, true);
+        for (uint32_t i = binStart[tile]; i < binStart[tile + 1]; ++i) {
+            const DrawCommand& command = commands[binCommands[i]];
+            if (command.bounds.intersects(clip)) executeDrawCommand(command, dst, clip);
+        }
+    }
+}
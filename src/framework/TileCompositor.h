@@ -0,0 +1,71 @@
+#pragma once
+#include "DrawList.h"
+#include "FrameArena.h"
+#include "Surface.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Rasterizes a frame's draw list tile by tile across threads. Commands are
+// binned into fixed screen tiles; each tile then restores the background
+// and replays its own bin, in list order, clipped to the tile. Tiles never
+// share pixels, so workers write the framebuffer without locks and the
+// result is bit-identical to drawing the whole list on one thread.
+//
+// The workers are parked between frames and the bins come from the frame
+// arena, so a steady-state frame doesn't touch the heap.
+class TileCompositor {
+public:
+    static constexpr int TILE_SIZE = 128;
+    // Below this many dirty pixels the frame is drawn on the calling thread;
+    // waking the workers would cost more than it saves.
+    static constexpr long long MIN_PARALLEL_PIXELS = 256 * 256;
+
+    // threadCount 0 uses every hardware thread; the calling thread is one of
+    // them. The arena must be reset between frames, never during render().
+    TileCompositor(size_t threadCount, FrameArena& arena);
+    ~TileCompositor();
+    TileCompositor(const TileCompositor&) = delete;
+    TileCompositor& operator=(const TileCompositor&) = delete;
+
+    size_t getThreadCount() const { return threadCount; }
+
+    // For every rect: copies background into it, then draws list over it.
+    void render(const DrawList& list, const Surface& dst, const Surface& background, const ClipRect* rects, size_t rectCount);
+
+private:
+    size_t threadCount;
+    FrameArena& arena;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    uint64_t generation = 0;
+    size_t running = 0;
+    bool stopping = false;
+
+    // Per-frame state. Tile t's commands are binCommands[binStart[t]] up to
+    // binStart[t + 1], in list order.
+    const DrawList* list = nullptr;
+    Surface dst;
+    Surface background;
+    const ClipRect* rects = nullptr;
+    size_t rectCount = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    FrameVector<uint8_t> tileDirty;
+    FrameVector<uint32_t> activeTiles;
+    FrameVector<uint32_t> binStart;
+    FrameVector<uint32_t> binFill;
+    FrameVector<uint32_t> binCommands;
+    std::atomic<size_t> nextTile{ 0 };
+
+    void bin();
+    void renderTile(uint32_t tile);
+    void drainTiles();
+    void workerLoop();
+};
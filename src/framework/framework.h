@@ -0,0 +1,142 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "FrameArena.h"
+#include "FramePacer.h"
+#include "Surface.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#if defined(_WINDOWS)
+#if defined(FRAMEWORK_PROJECT)
+#define FRAMEWORK_API __declspec(dllexport)
+#else
+#define FRAMEWORK_API __declspec(dllimport)
+#endif
+#else
+#define FRAMEWORK_API 
+#endif
+
+// Decoded premultiplied BGRA pixels plus the size the sprite is drawn at.
+// Sprites either own their pixels or reference memory that outlives them.
+class Sprite {
+private:
+    std::vector<uint32_t> storage;
+    Surface surface;
+    int width;
+    int height;
+    bool opaque;
+public:
+    Sprite(int w, int h, std::vector<uint32_t>&& pixels, bool isOpaque)
+        : storage(std::move(pixels))
+        , width(w)
+        , height(h)
+        , opaque(isOpaque)
+    {
+        if (w <= 0 || h <= 0 || storage.size() != static_cast<size_t>(w) * h) throw std::runtime_error("Invalid pixels in Sprite constructor");
+        surface = { storage.data(), w, h, w };
+    }
+
+    Sprite(const Surface& pixels, bool isOpaque)
+        : surface(pixels)
+        , width(pixels.width)
+        , height(pixels.height)
+        , opaque(isOpaque)
+    { if (!pixels.pixels || pixels.width <= 0 || pixels.height <= 0) throw std::runtime_error("Invalid surface in Sprite constructor"); }
+
+    const Surface& getSurface() const { return surface; }
+    bool isOpaque() const { return opaque; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    void setSize(int w, int h) { width = w; height = h; }
+};
+
+enum class FRKey {
+    RIGHT,
+    LEFT,
+    DOWN,
+    UP,
+    COUNT
+};
+
+enum class FRMouseButton {
+    LEFT,
+    MIDDLE,
+    RIGHT,
+    COUNT
+};
+
+class Framework {
+public:
+    virtual void PreInit(int& width, int& height, bool& fullscreen) = 0;
+    virtual bool Init() = 0;
+    virtual void Close() = 0;
+    virtual bool Tick() = 0;
+    virtual void onMouseMove(int x, int y, int xrelative, int yrelative) = 0;
+    virtual void onMouseButtonClick(FRMouseButton button, bool isReleased) = 0;
+    virtual void onKeyPressed(FRKey k) = 0;
+    virtual void onKeyReleased(FRKey k) = 0;
+    virtual const char* GetTitle() = 0;
+    // Called once the frame the last Tick drew is on screen.
+    virtual void onFramePresented() {}
+    virtual ~Framework() = default;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    // Drawing goes to a software back buffer. A null pixels pointer makes the
+    // framework allocate it; the Win32 backend passes its DIB section instead.
+    FRAMEWORK_API bool createFramebuffer(int width, int height, uint32_t* pixels);
+    FRAMEWORK_API void destroyFramebuffer();
+    FRAMEWORK_API const Surface* getFramebuffer();
+    FRAMEWORK_API Sprite* getGameScoreSprite();
+    FRAMEWORK_API void setBackgroundSprite(const char* path);
+    FRAMEWORK_API void setScoreSprite(const char* path);
+    // Uses already decoded layers; both must outlive their use as the background.
+    FRAMEWORK_API void setBackgroundLayers(const Sprite* backdrop, const Sprite* scoreBar);
+    FRAMEWORK_API bool hasBackgroundLayers();
+    // Serves createSprite from a DoodlePack archive where it has the path.
+    // Sprites made from it point into the mapping, so unmount only once
+    // they are all gone.
+    FRAMEWORK_API bool mountAssetArchive(const char* path);
+    FRAMEWORK_API void unmountAssetArchive();
+    FRAMEWORK_API Sprite* createSprite(const char* path);
+    FRAMEWORK_API void drawSprite(const Sprite* sprite, int x, int y);
+    FRAMEWORK_API void drawSpriteRotated(const Sprite* sprite, int x, int y, float angle);
+    FRAMEWORK_API void fillRect(int x, int y, int width, int height, uint32_t color);
+    FRAMEWORK_API void getSpriteSize(const Sprite* sprite, int& width, int& height);
+    FRAMEWORK_API void setSpriteSize(Sprite* sprite, int width, int height);
+    FRAMEWORK_API void destroySprite(Sprite* sprite);
+    FRAMEWORK_API void drawTestBackground();
+    // Frames drawn between these two are only recorded, then redrawn where they
+    // differ from the previous frame. endFrame returns the regions of the back
+    // buffer that changed (count may be 0). invalidateFramebuffer makes the
+    // next frame redraw everything, e.g. after the view scrolled.
+    FRAMEWORK_API void beginFrame();
+    FRAMEWORK_API const ClipRect* endFrame(int& count);
+    FRAMEWORK_API void invalidateFramebuffer();
+    // Threads endFrame rasterizes with; 0 (the default) uses every hardware
+    // thread. The output is the same for any count.
+    FRAMEWORK_API void setRenderThreads(int threads);
+    // Scratch memory for the current frame, reset by beginFrame. Anything
+    // drawn between beginFrame and endFrame may use it for transient data.
+    FRAMEWORK_API FrameArena& getFrameArena();
+    FRAMEWORK_API void getScreenSize(int& width, int& height);
+#ifdef _WIN32
+    FRAMEWORK_API HDC getHDC();
+    FRAMEWORK_API unsigned int getTickCount();
+    FRAMEWORK_API void showCursor(bool show);
+    // Frames per second run() holds the loop to; 0 runs uncapped. Set before run().
+    FRAMEWORK_API void setFrameRateLimit(int fps);
+    // Frame intervals measured by the last run().
+    FRAMEWORK_API void getFramePacingStats(FramePacingStats& stats);
+    FRAMEWORK_API int run(Framework* framework);
+#endif
+#ifdef __cplusplus
+}
+#endif
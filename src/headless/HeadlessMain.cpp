@@ -0,0 +1,148 @@
+#include "World.h"
+#include "Agent.h"
+#include "FixedTimestep.h"
+#include "GameConfig.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Runs the simulation with no window for a fixed number of ticks and reports
+// throughput. Input comes from an agent (--agent, heuristic by default) as key
+// and mouse events, so its sessions can be recorded and replayed (--record /
+// --replay) like a real one.
+namespace {
+    void printPool(const char* name, const PoolStats& stats) {
+        printf("%s pool: capacity %zu, live %zu, high water %zu, exhausted %zu\n",
+            name, stats.capacity, stats.live, stats.highWater, stats.exhausted);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    GameConfig config = GameConfig::parseCommandLine(argc, argv);
+    long long ticks = 36000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = atoll(argv[++i]);
+    }
+
+    if (config.agent.empty()) config.agent = "heuristic";
+    std::unique_ptr<Agent> agent = createAgent(config.agent, config);
+    if (!agent) { fprintf(stderr, "unknown agent %s\n", config.agent.c_str()); return 1; }
+
+    InputRecording replay;
+    bool replaying = !config.replayPath.empty();
+    if (replaying) {
+        if (!replay.load(config.replayPath.c_str())) { fprintf(stderr, "cannot read recording %s\n", config.replayPath.c_str()); return 1; }
+        replay.applyTo(config);
+        ticks = replay.finalTick;
+    }
+
+    // Headless runs are unthrottled, so every iteration is exactly one fixed step.
+    FixedTimestep timestep(config.tickRate);
+    float deltaTime = timestep.getStep();
+
+    World world(config, config.windowWidth, config.windowHeight);
+    Profiler::setEnabled(config.debugMode);
+
+    bool recordingSession = !config.recordPath.empty();
+    InputRecording recording;
+    if (recordingSession) recording.begin(config, config.windowWidth, config.windowHeight);
+    InputTranslator translator;
+    ReplayCursor cursor(replay);
+
+    int games = 1;
+    int bestScore = 0;
+    int bestPlatforms = 0;
+    uint32_t tick = 0;
+    Observation observation;
+    std::vector<InputEvent> actions;
+    actions.reserve(MAX_ACTION_EVENTS);
+
+    auto emit = [&](InputEvent event) {
+        event.tick = tick;
+        event.timeMs = static_cast<uint32_t>(tick * static_cast<double>(deltaTime) * 1000.0);
+        if (recordingSession) recording.record(event);
+        translator.apply(event, world);
+    };
+    auto resetGame = [&]() {
+        bestScore = world.getScore() > bestScore ? world.getScore() : bestScore;
+        bestPlatforms = world.getPlayer()->getPlatformsCount() > bestPlatforms ? world.getPlayer()->getPlatformsCount() : bestPlatforms;
+        if (config.debugMode) printf("game %d over: score %d, platforms %d\n", games, world.getScore(), world.getPlayer()->getPlatformsCount());
+        world.reset();
+        ++games;
+    };
+
+    auto deliverReplay = [&]() {
+        cursor.deliver(tick, [&](const InputEvent& event) {
+            if (event.type == InputEventType::GameReset) resetGame();
+            else translator.apply(event, world);
+        });
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    while (tick < ticks) {
+        if (replaying) deliverReplay();
+        else {
+            actions.clear();
+            observe(world, tick, observation);
+            appendActionEvents(agent->act(observation), world, actions);
+            for (const InputEvent& event : actions) emit(event);
+        }
+
+        world.step(deltaTime);
+        ++tick;
+        DJ_PROFILE_FRAME();
+
+        if (recordingSession) recording.afterStep(tick, world);
+        if (replaying && !cursor.afterStep(tick, world)) break;
+        if (!replaying && world.isGameOver()) {
+            InputEvent reset;
+            reset.type = InputEventType::GameReset;
+            emit(reset);
+            resetGame();
+        }
+    }
+    // A recording that ends on a game over holds that tick's reset, and its
+    // final checkpoint was taken after it.
+    if (replaying && !cursor.hasDiverged()) deliverReplay();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("seed: %llu, agent: %s\n", static_cast<unsigned long long>(config.seed), replaying ? "replay" : agent->getName());
+    printf("ticks: %u (%.1f s simulated)\n", tick, tick * deltaTime);
+    printf("wall time: %.3f s, %.0f ticks/s, %.0fx real time\n", seconds, seconds > 0 ? tick / seconds : 0.0,
+        seconds > 0 ? tick * deltaTime / seconds : 0.0);
+    printf("games: %d, best score: %d, best platforms: %d\n", games, bestScore, bestPlatforms);
+    printf("current game: score %d, platforms %d, entities %zu platforms / %zu enemies / %zu projectiles\n",
+        world.getScore(), world.getPlayer()->getPlatformsCount(),
+        world.getPlatforms().size(), world.getEnemies().size(), world.getProjectiles().size());
+    printPool("platform", world.getPlatformPoolStats());
+    printPool("enemy", world.getEnemyPoolStats());
+    printPool("projectile", world.getProjectilePoolStats());
+    const LevelStreamStats& level = world.getLevelStats();
+    printf("level chunks: %llu streamed, %llu generated in the step, %llu discarded\n", static_cast<unsigned long long>(level.streamed),
+        static_cast<unsigned long long>(level.generated), static_cast<unsigned long long>(level.discarded));
+
+    if (config.debugMode) {
+        Profiler::printSummary();
+        if (Profiler::writeChromeTrace("doodle_trace.json")) printf("trace written to doodle_trace.json\n");
+    }
+
+    if (recordingSession) {
+        recording.finish(tick, world);
+        if (!recording.save(config.recordPath.c_str())) { fprintf(stderr, "cannot write recording %s\n", config.recordPath.c_str()); return 1; }
+        printf("recorded %zu events, %zu checkpoints to %s\n", recording.events.size(), recording.checkpoints.size(), config.recordPath.c_str());
+    }
+    if (replaying) {
+        if (!cursor.hasDiverged()) cursor.finish(tick, world);
+        if (cursor.hasDiverged()) {
+            fprintf(stderr, "REPLAY DIVERGED: %s\n", cursor.getError().c_str());
+            return 1;
+        }
+        printf("replay matched: %u ticks, %zu events, final score %d\n", tick, replay.events.size(), world.getScore());
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "GameConfig.h"
+#include "LevelGenerator.h"
+#include "Random.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Fails if a generated level can't be climbed without touching an enemy.
+// Sweeps many seeds through LevelGenerator and checks, from the chunks alone:
+// - every route gap is within the jump's vertical and sideways reach;
+// - no enemy, nor the platform it stands on, comes within ENEMY_CLEARANCE of
+//   the columns a route jump covers while the player's body could be level
+//   with it. A jump covers the columns between its two platforms and the
+//   height from its start up to the top of the player at the apex.
+namespace {
+    struct RoutePlatform { float x, y; };
+    struct PlacedEnemy { float left, right, top, bottom; };
+
+    struct Counts {
+        long long route = 0;
+        long long enemies = 0;
+        long long tooFar = 0;
+        long long blocked = 0;
+    };
+
+    void checkSeed(const LevelGenerator& generator, const GameConfig& config, uint64_t seed, int chunks, Counts& counts) {
+        float startX = config.windowWidth / 2.0f - GameConstants::PLATFORM_WIDTH / 2.0f;
+        float startY = config.windowHeight - 65.0f;
+        std::vector<RoutePlatform> route{ { startX, startY } };
+        std::vector<PlacedEnemy> enemies;
+
+        LevelCursor cursor = generator.begin(seed, startX, startY);
+        LevelChunk chunk;
+        for (int i = 0; i < chunks; ++i) {
+            generator.generate(cursor, 0, chunk);
+            cursor = chunk.next;
+            for (int p = 0; p < chunk.count; ++p) {
+                const ChunkPlatform& platform = chunk.platforms[p];
+                if (platform.flags & CHUNK_SPINE) { route.push_back({ platform.x, platform.y }); continue; }
+                if (platform.enemyType < 0) continue;
+                float overhang = std::max(0.0f, (GameConstants::ENEMY_TYPE_WIDTH[platform.enemyType] - GameConstants::PLATFORM_WIDTH) / 2.0f);
+                enemies.push_back({ platform.x - overhang, platform.x + GameConstants::PLATFORM_WIDTH + overhang,
+                    platform.y - GameConstants::ENEMY_TYPE_HEIGHT[platform.enemyType], platform.y });
+            }
+        }
+
+        for (size_t r = 1; r < route.size(); ++r) {
+            int interval = static_cast<int>(route[r - 1].y - route[r].y + 0.5f);
+            float dx = std::abs(route[r].x - route[r - 1].x);
+            if (interval > generator.getMaxInterval() || dx > generator.getHorizontalReach(interval) + 1.0f) ++counts.tooFar;
+        }
+
+        // Both lists run bottom to top, so each enemy only needs the jumps
+        // that start within reach below it.
+        size_t firstJump = 1;
+        float sweep = generator.getJumpRise() + GameConstants::PLAYER_HEIGHT;
+        for (const PlacedEnemy& enemy : enemies) {
+            while (firstJump < route.size() && route[firstJump - 1].y - sweep >= enemy.bottom) ++firstJump;
+            for (size_t r = firstJump; r < route.size() && route[r - 1].y > enemy.top; ++r) {
+                float left = std::min(route[r - 1].x, route[r].x);
+                float right = std::max(route[r - 1].x, route[r].x) + GameConstants::PLATFORM_WIDTH;
+                if (enemy.left < right + LevelGenerator::ENEMY_CLEARANCE && enemy.right > left - LevelGenerator::ENEMY_CLEARANCE) {
+                    ++counts.blocked;
+                    break;
+                }
+            }
+        }
+        counts.route += static_cast<long long>(route.size());
+        counts.enemies += static_cast<long long>(enemies.size());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    GameConfig config = GameConfig::parseCommandLine(argc, argv);
+    long long seeds = 200;
+    int chunks = 60;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) seeds = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--chunks") == 0 && i + 1 < argc) chunks = atoi(argv[++i]);
+    }
+
+    LevelGenerator generator(config, config.windowWidth);
+    Counts counts;
+    for (long long i = 0; i < seeds; ++i) {
+        // Levels are seeded the way World seeds them, from the Level stream.
+        Pcg32 levelRng(config.seed + static_cast<uint64_t>(i), static_cast<uint64_t>(RandomStream::Level));
+        uint64_t levelSeed = static_cast<uint64_t>(levelRng.next()) << 32;
+        levelSeed |= levelRng.next();
+        checkSeed(generator, config, levelSeed, chunks, counts);
+    }
+
+    printf("levels: %lld seeds x %d chunks, %lld route platforms, %lld enemies\n", seeds, chunks, counts.route, counts.enemies);
+    printf("route gaps out of reach: %lld\n", counts.tooFar);
+    printf("enemies in the route's way: %lld\n", counts.blocked);
+    bool ok = counts.tooFar == 0 && counts.blocked == 0;
+    printf(ok ? "PASS: every level can be climbed without a kill\n" : "FAIL: some levels need a kill or an impossible jump\n");
+    return ok ? 0 : 1;
+}
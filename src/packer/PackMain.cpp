@@ -0,0 +1,64 @@
+#include "AssetArchive.h"
+#include "ImageDecoder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Build-time packer: decodes every PNG and JPEG in a directory once and
+// writes the premultiplied pixels into an archive the game memory-maps.
+// Entries are named the way the game asks for them, "<prefix>/<file>", with
+// the directory's own name as the default prefix. Images that fail to decode
+// are left out with a warning; the game then loads those from the loose file.
+int main(int argc, char* argv[]) {
+    const char* directory = nullptr;
+    const char* output = nullptr;
+    std::string prefix;
+    bool prefixSet = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--prefix") == 0 && i + 1 < argc) { prefix = argv[++i]; prefixSet = true; }
+        else if (!directory) directory = argv[i];
+        else if (!output) output = argv[i];
+    }
+    if (!directory || !output) {
+        fprintf(stderr, "usage: DoodlePack <directory> <archive> [--prefix <name>]\n");
+        return 2;
+    }
+
+    std::filesystem::path root(directory);
+    if (!prefixSet) prefix = root.lexically_normal().filename().string();
+    if (prefix.empty()) prefix = root.lexically_normal().parent_path().filename().string();
+
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(root, error)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg") files.push_back(entry.path());
+    }
+    if (error) { fprintf(stderr, "cannot read %s: %s\n", directory, error.message().c_str()); return 1; }
+
+    std::vector<PackedImage> images;
+    size_t bytes = 0;
+    for (const std::filesystem::path& file : files) {
+        DecodedImage decoded;
+        if (!decodeImage(file.string().c_str(), decoded)) {
+            fprintf(stderr, "warning: cannot decode %s, leaving it out\n", file.string().c_str());
+            continue;
+        }
+        PackedImage image;
+        image.name = prefix.empty() ? file.filename().string() : prefix + "/" + file.filename().string();
+        image.width = decoded.width;
+        image.height = decoded.height;
+        image.opaque = decoded.opaque;
+        image.pixels = std::move(decoded.pixels);
+        bytes += image.pixels.size() * sizeof(uint32_t);
+        images.push_back(std::move(image));
+    }
+
+    if (!writeAssetArchive(output, images)) { fprintf(stderr, "cannot write %s\n", output); return 1; }
+    printf("Packed %zu of %zu images (%zu pixel bytes) into %s\n", images.size(), files.size(), bytes, output);
+    return 0;
+}
@@ -53,13 +53,23 @@ int WINAPI WinMain(
         printf("Game instance created\n");
 #endif
 
+        setFrameRateLimit(config.targetFps);
+        setRenderThreads(config.renderThreads);
         int result = run(game.get());
 
+        if (config.debugMode) {
+            FramePacingStats pacing;
+            getFramePacingStats(pacing);
+            printf("Frame pacing: %zu frames, target %.3f ms, mean %.3f ms, jitter %.3f ms, p99 error %.3f ms, max error %.3f ms\n",
+                pacing.frames, pacing.targetMs, pacing.meanMs, pacing.jitterMs, pacing.p99ErrorMs, pacing.maxErrorMs);
+        }
+
 #ifdef _DEBUG
         printf("Game finished with result: %d\n", result);
 #endif
 
-        return result;
+        // A diverged replay must fail the process so scripted runs notice.
+        return game->hasReplayFailed() ? 1 : result;
     }
     catch (const std::exception& e) {
 #ifdef _DEBUG